@@ -0,0 +1,244 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/container/flat_map.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace crow
+{
+
+struct AdmissionLimits
+{
+    // Connections that may be served at once
+    size_t maxConnections;
+    // Connections, served or queued, that a single client address may hold.
+    // 0 for no limit.
+    size_t maxPerClient;
+    // Connections that may wait for a slot once maxConnections is reached
+    size_t maxQueued;
+    // Connections that may be in the process of being sent a 503 at once.
+    // Beyond this, connections are closed without a response.
+    size_t maxRejecting;
+};
+
+struct AdmissionMetrics
+{
+    size_t active = 0;
+    size_t queued = 0;
+    size_t admitted = 0;
+    // Connections that were admitted after waiting in the queue
+    size_t admittedFromQueue = 0;
+    size_t rejectedPerClient = 0;
+    size_t rejectedFull = 0;
+    size_t queueTimeouts = 0;
+    // Connections closed without a response
+    size_t dropped = 0;
+};
+
+// Decides whether a new connection is served, made to wait for a slot, or
+// turned away.  Connections may start and finish on different threads, so
+// all state is guarded by a mutex.
+class AdmissionController
+{
+  public:
+    enum class Decision
+    {
+        Admit,
+        Queue,
+        // Send a 503 with Retry-After, then close
+        Reject,
+        // Close without reading anything
+        Drop,
+    };
+
+    // How long a queued connection waits for a slot before being rejected
+    static constexpr std::chrono::seconds queueTimeout{5};
+    // Sent with 503 responses, giving clients a hint of when to come back
+    static constexpr std::chrono::seconds retryAfter{5};
+
+    explicit AdmissionController(const AdmissionLimits& limitsIn) :
+        limits(limitsIn)
+    {}
+
+    static AdmissionController& getInstance()
+    {
+        static AdmissionController controller(AdmissionLimits{
+            .maxConnections =
+                static_cast<size_t>(BMCWEB_HTTP_MAX_CONNECTIONS),
+            .maxPerClient =
+                static_cast<size_t>(BMCWEB_HTTP_MAX_CONNECTIONS_PER_CLIENT),
+            .maxQueued = static_cast<size_t>(BMCWEB_HTTP_CONNECTION_QUEUE_SIZE),
+            .maxRejecting = 64,
+        });
+        return controller;
+    }
+
+    // Called when a connection is accepted.  On Queue, ticket identifies the
+    // connection, and onAdmitted is later called, from whichever thread frees
+    // up a slot, unless the connection is cancelled first.
+    Decision admit(const boost::asio::ip::address& client, uint64_t& ticket,
+                   std::function<void()>&& onAdmitted)
+    {
+        std::scoped_lock lock(mutex);
+        size_t& clientCount = clients[client];
+        if (limits.maxPerClient != 0 && clientCount >= limits.maxPerClient)
+        {
+            metrics.rejectedPerClient++;
+            BMCWEB_LOG_WARNING(
+                "Client {} is over its limit of {} connections, {} rejected so far",
+                client.to_string(), limits.maxPerClient,
+                metrics.rejectedPerClient);
+            eraseIfUnused(client);
+            return rejectLocked();
+        }
+        if (metrics.active < limits.maxConnections)
+        {
+            clientCount++;
+            metrics.active++;
+            metrics.admitted++;
+            return Decision::Admit;
+        }
+        if (waiters.size() < limits.maxQueued)
+        {
+            clientCount++;
+            ticket = nextTicket++;
+            waiters.push_back({ticket, client, std::move(onAdmitted)});
+            metrics.queued = waiters.size();
+            BMCWEB_LOG_DEBUG("Connection limit reached, {} queued",
+                             waiters.size());
+            return Decision::Queue;
+        }
+        metrics.rejectedFull++;
+        BMCWEB_LOG_WARNING(
+            "Max connection count of {} exceeded, {} rejected so far",
+            limits.maxConnections, metrics.rejectedFull);
+        eraseIfUnused(client);
+        return rejectLocked();
+    }
+
+    // Withdraws a queued connection, because it waited too long.  Returns
+    // Admit if the connection was admitted in the meantime, and its
+    // onAdmitted is already on its way.
+    Decision cancel(uint64_t ticket)
+    {
+        std::optional<Waiter> waiter;
+        Decision decision = Decision::Admit;
+        {
+            std::scoped_lock lock(mutex);
+            auto it = std::ranges::find(waiters, ticket, &Waiter::ticket);
+            if (it == waiters.end())
+            {
+                return Decision::Admit;
+            }
+            waiter = std::move(*it);
+            waiters.erase(it);
+            metrics.queued = waiters.size();
+            metrics.queueTimeouts++;
+            releaseClientLocked(waiter->client);
+            decision = rejectLocked();
+        }
+        // The callback may hold the last reference to the connection, whose
+        // destructor comes back here, so it's destroyed outside the lock
+        waiter.reset();
+        return decision;
+    }
+
+    // Called when an admitted connection closes, handing its slot to the
+    // longest waiting connection
+    void release(const boost::asio::ip::address& client)
+    {
+        std::function<void()> onAdmitted;
+        {
+            std::scoped_lock lock(mutex);
+            releaseClientLocked(client);
+            metrics.active--;
+            if (waiters.empty())
+            {
+                return;
+            }
+            onAdmitted = std::move(waiters.front().onAdmitted);
+            waiters.pop_front();
+            metrics.queued = waiters.size();
+            metrics.active++;
+            metrics.admitted++;
+            metrics.admittedFromQueue++;
+        }
+        onAdmitted();
+    }
+
+    // Called when a rejected connection closes
+    void rejectDone()
+    {
+        std::scoped_lock lock(mutex);
+        rejecting--;
+    }
+
+    AdmissionMetrics getMetrics() const
+    {
+        std::scoped_lock lock(mutex);
+        return metrics;
+    }
+
+  private:
+    struct Waiter
+    {
+        uint64_t ticket;
+        boost::asio::ip::address client;
+        std::function<void()> onAdmitted;
+    };
+
+    Decision rejectLocked()
+    {
+        if (rejecting >= limits.maxRejecting)
+        {
+            metrics.dropped++;
+            return Decision::Drop;
+        }
+        rejecting++;
+        return Decision::Reject;
+    }
+
+    void releaseClientLocked(const boost::asio::ip::address& client)
+    {
+        auto it = clients.find(client);
+        if (it == clients.end())
+        {
+            return;
+        }
+        it->second--;
+        eraseIfUnused(client);
+    }
+
+    void eraseIfUnused(const boost::asio::ip::address& client)
+    {
+        auto it = clients.find(client);
+        if (it != clients.end() && it->second == 0)
+        {
+            clients.erase(it);
+        }
+    }
+
+    const AdmissionLimits limits;
+
+    mutable std::mutex mutex;
+    boost::container::flat_map<boost::asio::ip::address, size_t> clients;
+    std::deque<Waiter> waiters;
+    uint64_t nextTicket = 0;
+    size_t rejecting = 0;
+    AdmissionMetrics metrics;
+};
+
+} // namespace crow
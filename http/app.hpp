@@ -148,6 +148,16 @@ class App
         return router.getRoutes(parent);
     }
 
+    std::vector<const BaseRule*> getAllRules() const
+    {
+        return router.getAllRules();
+    }
+
+    Router::FindRouteResponse findRoute(const Request& req) const
+    {
+        return router.findRoute(req);
+    }
+
     App& ssl(std::shared_ptr<boost::asio::ssl::context>&& ctx)
     {
         sslContext = std::move(ctx);
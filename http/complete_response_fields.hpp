@@ -1,7 +1,10 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "authentication.hpp"
 #include "boost_formatters.hpp"
+#include "content_encoding.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "http_utility.hpp"
@@ -14,10 +17,74 @@
 #include <nlohmann/json.hpp>
 
 #include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace crow
 {
 
+inline int getJsonIndent(const Request& req)
+{
+    http_helpers::JsonFormat format =
+        http_helpers::getJsonFormat(req.getHeaderValue("Accept"));
+    if (format == http_helpers::JsonFormat::Compact)
+    {
+        return -1;
+    }
+    if (format == http_helpers::JsonFormat::Pretty)
+    {
+        return 2;
+    }
+    return BMCWEB_COMPACT_JSON ? -1 : 2;
+}
+
+// Text based bodies that are worth spending CPU time to compress
+inline bool isCompressibleContentType(std::string_view contentType)
+{
+    return contentType.starts_with("application/json") ||
+           contentType.starts_with("application/xml") ||
+           contentType.starts_with("application/javascript") ||
+           contentType.starts_with("text/");
+}
+
+inline void compressResponse(const Request& req, Response& res)
+{
+    // Already encoded, like the prebuilt .gz static assets
+    if (!res.getHeaderValue(boost::beast::http::field::content_encoding)
+             .empty())
+    {
+        return;
+    }
+    if (!isCompressibleContentType(
+            res.getHeaderValue(boost::beast::http::field::content_type)))
+    {
+        return;
+    }
+    res.addHeader(boost::beast::http::field::vary, "Accept-Encoding");
+
+    // Compressed bodies are sent chunked, which HTTP/1.0 clients can't receive
+    if (req.version() < 11)
+    {
+        return;
+    }
+    // Bodies streamed with an unknown length are always large enough
+    std::optional<uint64_t> size = res.size();
+    if (size &&
+        (*size == 0 ||
+         *size < static_cast<uint64_t>(BMCWEB_HTTP_COMPRESSION_MIN_SIZE)))
+    {
+        return;
+    }
+    bmcweb::ContentEncoding encoding = bmcweb::getPreferredContentEncoding(
+        req.getHeaderValue(boost::beast::http::field::accept_encoding));
+    if (encoding == bmcweb::ContentEncoding::Identity)
+    {
+        return;
+    }
+    res.setContentEncoding(encoding);
+}
+
 inline void completeResponseFields(const Request& req, Response& res)
 {
     BMCWEB_LOG_INFO("Response:  {} {}", req.url().encoded_path(),
@@ -54,9 +121,14 @@ inline void completeResponseFields(const Request& req, Response& res)
             // backward compatibility.
             res.addHeader(boost::beast::http::field::content_type,
                           "application/json");
-            res.write(res.jsonValue.dump(
-                2, ' ', true, nlohmann::json::error_handler_t::replace));
+            // HTTP/1.0 clients can't receive a chunked body
+            res.writeJson(getJsonIndent(req), req.version() >= 11);
         }
     }
+
+    if constexpr (BMCWEB_HTTP_COMPRESSION)
+    {
+        compressResponse(req, res);
+    }
 }
 } // namespace crow
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace bmcweb
+{
+
+// Allocates from a memory_resource that it shares ownership of, so that
+// objects it allocates can safely outlive whoever created the resource.
+template <typename T>
+class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<std::pmr::memory_resource> resIn) :
+        resource(std::move(resIn))
+    {}
+
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    ArenaAllocator(const ArenaAllocator<U>& other) : resource(other.resource)
+    {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return resource == other.resource;
+    }
+
+  private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<std::pmr::memory_resource> resource;
+};
+
+// Memory for the Request and AsyncResp objects a connection creates for every
+// request it serves, together with their shared_ptr control blocks.  Blocks
+// freed by one request are reused by the next one on the same connection,
+// rather than each request going back to the global heap.  Only those objects
+// themselves come from the arena;  the JSON body, the header fields and
+// anything else they allocate still use the global heap.
+//
+// In a build with neither io threads nor worker threads, everything runs on
+// the main thread and the pool isn't locked.  Objects from the arena must
+// never be released on any other thread there, so work posted to the
+// WorkerPool must not capture a Request or AsyncResp.
+class ConnectionArena
+{
+  public:
+    // With more than one io thread, the last reference to a request may be
+    // dropped on a different thread than the connection runs on.  Worker
+    // threads are also allowed for, in case a reference reaches one.
+    using Resource = std::conditional_t<
+        (BMCWEB_HTTP_IO_THREADS > 1 || BMCWEB_WORKER_THREADS > 0),
+        std::pmr::synchronized_pool_resource,
+        std::pmr::unsynchronized_pool_resource>;
+
+    // Keep the chunks small, as most connections only serve a few requests
+    static constexpr std::pmr::pool_options poolOptions{
+        .max_blocks_per_chunk = 4,
+        .largest_required_pool_block = 2048,
+    };
+
+    ConnectionArena() : resource(std::make_shared<Resource>(poolOptions)) {}
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeShared(Args&&... args)
+    {
+        return std::allocate_shared<T>(ArenaAllocator<T>(resource),
+                                       std::forward<Args>(args)...);
+    }
+
+  private:
+    std::shared_ptr<Resource> resource;
+};
+
+} // namespace bmcweb
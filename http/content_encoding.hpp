@@ -0,0 +1,173 @@
+#pragma once
+
+#include "str_utility.hpp"
+
+#include <zlib.h>
+
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bmcweb
+{
+
+enum class ContentEncoding
+{
+    Identity,
+    Gzip,
+    Deflate,
+};
+
+inline std::string_view toString(ContentEncoding encoding)
+{
+    switch (encoding)
+    {
+        case ContentEncoding::Gzip:
+            return "gzip";
+        case ContentEncoding::Deflate:
+            return "deflate";
+        default:
+            return "identity";
+    }
+}
+
+// Returns false if the parameters of an Accept-Encoding entry contain a
+// q-value of zero, which explicitly marks that coding as not acceptable
+inline bool isCodingAcceptable(std::string_view params)
+{
+    while (!params.empty())
+    {
+        size_t semicolon = params.find(';');
+        std::string_view param = trimSpaces(params.substr(0, semicolon));
+        params.remove_prefix(semicolon == std::string_view::npos
+                                 ? params.size()
+                                 : semicolon + 1);
+        if (!param.starts_with("q=") && !param.starts_with("Q="))
+        {
+            continue;
+        }
+        std::string_view qvalue = param.substr(2);
+        // A qvalue is at most 1 digit, a decimal point, and 3 digits.  It is
+        // zero if every digit is zero.
+        return qvalue.find_first_not_of("0.") != std::string_view::npos;
+    }
+    return true;
+}
+
+// Picks the coding to use for a response from the Accept-Encoding header.
+// gzip is preferred over deflate, as some clients have historically
+// mishandled the zlib framing that "deflate" requires.
+inline ContentEncoding getPreferredContentEncoding(std::string_view header)
+{
+    // Codings that are explicitly listed take precedence over the wildcard
+    std::optional<bool> gzip;
+    std::optional<bool> deflate;
+    std::optional<bool> wildcard;
+    while (!header.empty())
+    {
+        size_t comma = header.find(',');
+        std::string_view coding = header.substr(0, comma);
+        header.remove_prefix(comma == std::string_view::npos ? header.size()
+                                                             : comma + 1);
+
+        size_t semicolon = coding.find(';');
+        std::string_view name = trimSpaces(coding.substr(0, semicolon));
+        bool acceptable = true;
+        if (semicolon != std::string_view::npos)
+        {
+            acceptable = isCodingAcceptable(coding.substr(semicolon + 1));
+        }
+        if (name == "gzip" || name == "x-gzip")
+        {
+            gzip = acceptable;
+        }
+        else if (name == "deflate")
+        {
+            deflate = acceptable;
+        }
+        else if (name == "*")
+        {
+            wildcard = acceptable;
+        }
+    }
+    bool anyCoding = wildcard.value_or(false);
+    if (gzip.value_or(anyCoding))
+    {
+        return ContentEncoding::Gzip;
+    }
+    if (deflate.value_or(anyCoding))
+    {
+        return ContentEncoding::Deflate;
+    }
+    return ContentEncoding::Identity;
+}
+
+// Incrementally compresses a body using zlib.  z_stream keeps a pointer to
+// itself in its internal state, so this class can't be moved once
+// initialized.
+class ContentEncoder
+{
+  public:
+    ContentEncoder() = default;
+
+    ContentEncoder(const ContentEncoder&) = delete;
+    ContentEncoder(ContentEncoder&&) = delete;
+    ContentEncoder& operator=(const ContentEncoder&) = delete;
+    ContentEncoder& operator=(ContentEncoder&&) = delete;
+
+    ~ContentEncoder()
+    {
+        if (initialized)
+        {
+            deflateEnd(&stream);
+        }
+    }
+
+    bool init(ContentEncoding encoding, int level)
+    {
+        // Adding 16 to the window bits requests a gzip header and trailer in
+        // place of the zlib ones
+        int windowBits = encoding == ContentEncoding::Gzip ? 15 + 16 : 15;
+        initialized = deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8,
+                                   Z_DEFAULT_STRATEGY) == Z_OK;
+        return initialized;
+    }
+
+    // Compresses all of in, appending any output zlib produces to out.  When
+    // finish is set, the stream is flushed and terminated.
+    bool compress(std::string_view in, bool finish, std::string& out)
+    {
+        if (!initialized)
+        {
+            return false;
+        }
+        // zlib predates const correctness, but never writes to next_in
+        stream.next_in = std::bit_cast<Bytef*>(in.data());
+        stream.avail_in = static_cast<uInt>(in.size());
+        int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+        do
+        {
+            size_t used = out.size();
+            out.resize(used + outChunkSize);
+            stream.next_out = std::bit_cast<Bytef*>(&out[used]);
+            stream.avail_out = static_cast<uInt>(outChunkSize);
+            int ret = deflate(&stream, flush);
+            out.resize(used + outChunkSize - stream.avail_out);
+            if (ret == Z_STREAM_ERROR)
+            {
+                return false;
+            }
+        } while (stream.avail_out == 0);
+        return true;
+    }
+
+  private:
+    static constexpr size_t outChunkSize = 1024UL * 16UL;
+
+    z_stream stream{};
+    bool initialized = false;
+};
+
+} // namespace bmcweb
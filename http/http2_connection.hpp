@@ -183,6 +183,12 @@ class HTTP2Connection :
             headerFromStringViews(":status", code, NGHTTP2_NV_FLAG_NONE));
         for (const boost::beast::http::fields::value_type& header : fields)
         {
+            // Chunking is an HTTP/1.1 concept;  HTTP/2 frames the body itself
+            // and forbids the header
+            if (header.name() == boost::beast::http::field::transfer_encoding)
+            {
+                continue;
+            }
             hdr.emplace_back(headerFromStringViews(
                 header.name_string(), header.value(), NGHTTP2_NV_FLAG_NONE));
         }
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
+#include "content_encoding.hpp"
+#include "json_stream_serializer.hpp"
 #include "logging.hpp"
 #include "utility.hpp"
 
@@ -12,6 +16,7 @@
 #include <boost/system/error_code.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string_view>
 
@@ -40,9 +45,16 @@ class HttpBody::value_type
     boost::beast::file_posix fileHandle;
     std::optional<size_t> fileSize;
     std::string strBody;
+    // A body shared with other messages, sent in place of strBody
+    std::shared_ptr<const std::string> sharedBody;
+    // Json that is still being serialized as the body is written.  Shared on
+    // copy, as a partially consumed serializer can't be duplicated.
+    std::shared_ptr<JsonStreamSerializer> jsonStream;
 
   public:
     EncodingType encodingType = EncodingType::Raw;
+    // Compression applied on top of encodingType as the body is written
+    ContentEncoding contentEncoding = ContentEncoding::Identity;
 
     ~value_type() = default;
     value_type() = default;
@@ -51,7 +63,11 @@ class HttpBody::value_type
 
     value_type(value_type&& other) noexcept :
         fileHandle(std::move(other.fileHandle)), fileSize(other.fileSize),
-        strBody(std::move(other.strBody)), encodingType(other.encodingType)
+        strBody(std::move(other.strBody)),
+        sharedBody(std::move(other.sharedBody)),
+        jsonStream(std::move(other.jsonStream)),
+        encodingType(other.encodingType),
+        contentEncoding(other.contentEncoding)
     {}
 
     value_type& operator=(value_type&& other) noexcept
@@ -59,7 +75,10 @@ class HttpBody::value_type
         fileHandle = std::move(other.fileHandle);
         fileSize = other.fileSize;
         strBody = std::move(other.strBody);
+        sharedBody = std::move(other.sharedBody);
+        jsonStream = std::move(other.jsonStream);
         encodingType = other.encodingType;
+        contentEncoding = other.contentEncoding;
 
         return *this;
     }
@@ -68,7 +87,9 @@ class HttpBody::value_type
     // does
     value_type(const value_type& other) :
         fileSize(other.fileSize), strBody(other.strBody),
-        encodingType(other.encodingType)
+        sharedBody(other.sharedBody), jsonStream(other.jsonStream),
+        encodingType(other.encodingType),
+        contentEncoding(other.contentEncoding)
     {
         fileHandle.native_handle(dup(other.fileHandle.native_handle()));
     }
@@ -79,7 +100,10 @@ class HttpBody::value_type
         {
             fileSize = other.fileSize;
             strBody = other.strBody;
+            sharedBody = other.sharedBody;
+            jsonStream = other.jsonStream;
             encodingType = other.encodingType;
+            contentEncoding = other.contentEncoding;
             fileHandle.native_handle(dup(other.fileHandle.native_handle()));
         }
         return *this;
@@ -100,11 +124,43 @@ class HttpBody::value_type
         return strBody;
     }
 
+    // Sends a string that's shared with other messages, such as an Event
+    // sent to several subscribers, without copying it
+    void setShared(std::shared_ptr<const std::string> shared)
+    {
+        sharedBody = std::move(shared);
+    }
+
+    // The string body that's sent, whether shared or not
+    const std::string& payload() const
+    {
+        if (sharedBody)
+        {
+            return *sharedBody;
+        }
+        return strBody;
+    }
+
+    const std::shared_ptr<JsonStreamSerializer>& json() const
+    {
+        return jsonStream;
+    }
+
+    void setJson(std::shared_ptr<JsonStreamSerializer> stream)
+    {
+        jsonStream = std::move(stream);
+    }
+
     std::optional<size_t> payloadSize() const
     {
+        if (jsonStream || contentEncoding != ContentEncoding::Identity)
+        {
+            // Length isn't known until serialization or compression completes
+            return std::nullopt;
+        }
         if (!fileHandle.is_open())
         {
-            return strBody.size();
+            return payload().size();
         }
         if (fileSize)
         {
@@ -120,9 +176,12 @@ class HttpBody::value_type
     {
         strBody.clear();
         strBody.shrink_to_fit();
+        sharedBody = nullptr;
+        jsonStream = nullptr;
         fileHandle = boost::beast::file_posix();
         fileSize = std::nullopt;
         encodingType = EncodingType::Raw;
+        contentEncoding = ContentEncoding::Identity;
     }
 
     void open(const char* path, boost::beast::file_mode mode,
@@ -182,6 +241,9 @@ class HttpBody::writer
 
     value_type& body;
     size_t sent = 0;
+    // Bytes handed out by the previous call when streaming json, which have
+    // been fully consumed by the time the next call is made
+    size_t jsonReturned = 0;
     // 64KB This number is arbitrary, and selected to try to optimize for larger
     // files and fewer loops over per-connection reduction in memory usage.
     // Nginx uses 16-32KB here, so we're in the range of what other webservers
@@ -189,6 +251,12 @@ class HttpBody::writer
     constexpr static size_t readBufSize = 1024UL * 64UL;
     std::array<char, readBufSize> fileReadBuf{};
 
+    // Only allocated when the body is being compressed
+    std::unique_ptr<ContentEncoder> contentEncoder;
+    std::string compressed;
+    size_t compressedReturned = 0;
+    bool compressionDone = false;
+
   public:
     template <bool IsRequest, class Fields>
     writer(boost::beast::http::header<IsRequest, Fields>& /*header*/,
@@ -209,16 +277,101 @@ class HttpBody::writer
 
     boost::optional<std::pair<const_buffers_type, bool>>
         getWithMaxSize(boost::beast::error_code& ec, size_t maxSize)
+    {
+        if (body.contentEncoding == ContentEncoding::Identity)
+        {
+            return getUncompressed(ec, maxSize);
+        }
+        return getCompressed(ec, maxSize);
+    }
+
+  private:
+    boost::optional<std::pair<const_buffers_type, bool>>
+        getCompressed(boost::beast::error_code& ec, size_t maxSize)
+    {
+        if (!contentEncoder)
+        {
+            contentEncoder = std::make_unique<ContentEncoder>();
+            if (!contentEncoder->init(body.contentEncoding,
+                                      BMCWEB_HTTP_COMPRESSION_LEVEL))
+            {
+                BMCWEB_LOG_CRITICAL("Failed to initialize compression");
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+                return boost::none;
+            }
+        }
+        // The previous call's output has been written by the time we're called
+        // again
+        compressed.erase(0, compressedReturned);
+        compressedReturned = 0;
+
+        // zlib buffers internally, so keep feeding it until it has produced
+        // something to send, or the body has ended
+        while (compressed.empty() && !compressionDone)
+        {
+            boost::optional<std::pair<const_buffers_type, bool>> raw =
+                getUncompressed(ec, readBufSize);
+            if (ec)
+            {
+                return boost::none;
+            }
+            std::string_view in;
+            bool more = false;
+            if (raw)
+            {
+                in = std::string_view(
+                    static_cast<const char*>(raw->first.data()),
+                    raw->first.size());
+                more = raw->second;
+            }
+            if (!contentEncoder->compress(in, !more, compressed))
+            {
+                BMCWEB_LOG_CRITICAL("Failed to compress body");
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return boost::none;
+            }
+            compressionDone = !more;
+        }
+
+        std::pair<const_buffers_type, bool> ret;
+        size_t toReturn = std::min(maxSize, compressed.size());
+        compressedReturned = toReturn;
+        ret.first = const_buffers_type(compressed.data(), toReturn);
+        ret.second = !compressionDone || toReturn < compressed.size();
+        BMCWEB_LOG_DEBUG("Returning {} compressed bytes more={}",
+                         ret.first.size(), ret.second);
+        return ret;
+    }
+
+    boost::optional<std::pair<const_buffers_type, bool>>
+        getUncompressed(boost::beast::error_code& ec, size_t maxSize)
     {
         std::pair<const_buffers_type, bool> ret;
+        const std::shared_ptr<JsonStreamSerializer>& json = body.json();
+        if (json)
+        {
+            json->consume(jsonReturned);
+            json->fill(std::min(readBufSize, maxSize));
+            std::string_view pending = json->pending();
+            std::string_view chunk = pending.substr(0, maxSize);
+            jsonReturned = chunk.size();
+            ret.first = const_buffers_type(chunk.data(), chunk.size());
+            ret.second = !json->isSerialized() || chunk.size() < pending.size();
+            BMCWEB_LOG_DEBUG("Returning {} json bytes more={}",
+                             ret.first.size(), ret.second);
+            return ret;
+        }
         if (!body.file().is_open())
         {
-            size_t remain = body.str().size() - sent;
+            const std::string& payload = body.payload();
+            size_t remain = payload.size() - sent;
             size_t toReturn = std::min(maxSize, remain);
-            ret.first = const_buffers_type(&body.str()[sent], toReturn);
+            ret.first = const_buffers_type(&payload[sent], toReturn);
 
             sent += toReturn;
-            ret.second = sent < body.str().size();
+            ret.second = sent < payload.size();
             BMCWEB_LOG_INFO("Returning {} bytes more={}", ret.first.size(),
                             ret.second);
             return ret;
@@ -724,7 +724,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         }
     }
 
-    void sendData(std::string&& data, const boost::urls::url_view_base& destUri,
+    void sendData(bmcweb::HttpBody::value_type&& body,
+                  const boost::urls::url_view_base& destUri,
                   const boost::beast::http::fields& httpHeader,
                   const boost::beast::http::verb verb,
                   const std::function<void(Response&)>& resHandler)
@@ -735,7 +736,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         thisReq.set(boost::beast::http::field::host,
                     destUri.encoded_host_address());
         thisReq.keep_alive(true);
-        thisReq.body().str() = std::move(data);
+        thisReq.body() = std::move(body);
         thisReq.prepare_payload();
         auto cb = std::bind_front(&ConnectionPool::afterSendData,
                                   weak_from_this(), resHandler);
@@ -883,6 +884,18 @@ class HttpClient
         sendDataWithCallback(std::move(data), destUri, httpHeader, verb, cb);
     }
 
+    // Send a body that's shared with other requests, such as an Event sent to
+    // several subscribers, without copying it
+    void sendData(std::shared_ptr<const std::string> data,
+                  const boost::urls::url_view_base& destUri,
+                  const boost::beast::http::fields& httpHeader,
+                  const boost::beast::http::verb verb)
+    {
+        bmcweb::HttpBody::value_type body;
+        body.setShared(std::move(data));
+        sendBody(std::move(body), destUri, httpHeader, verb, genericResHandler);
+    }
+
     // Send request to destIP and use the provided callback to
     // handle the response
     void sendDataWithCallback(std::string&& data,
@@ -890,6 +903,18 @@ class HttpClient
                               const boost::beast::http::fields& httpHeader,
                               const boost::beast::http::verb verb,
                               const std::function<void(Response&)>& resHandler)
+    {
+        bmcweb::HttpBody::value_type body;
+        body.str() = std::move(data);
+        sendBody(std::move(body), destUrl, httpHeader, verb, resHandler);
+    }
+
+  private:
+    void sendBody(bmcweb::HttpBody::value_type&& body,
+                  const boost::urls::url_view_base& destUrl,
+                  const boost::beast::http::fields& httpHeader,
+                  const boost::beast::http::verb verb,
+                  const std::function<void(Response&)>& resHandler)
     {
         std::string clientKey = std::format("{}://{}", destUrl.scheme(),
                                             destUrl.encoded_host_and_port());
@@ -901,7 +926,7 @@ class HttpClient
         }
         // Send the data using either the existing connection pool or the
         // newly created connection pool
-        pool.first->second->sendData(std::move(data), destUrl, httpHeader, verb,
+        pool.first->second->sendData(std::move(body), destUrl, httpHeader, verb,
                                      resHandler);
     }
 };
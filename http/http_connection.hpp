@@ -1,43 +1,54 @@
 #pragma once
 #include "bmcweb_config.h"
 
+#include "admission_controller.hpp"
 #include "async_resp.hpp"
 #include "authentication.hpp"
 #include "complete_response_fields.hpp"
+#include "connection_arena.hpp"
 #include "http2_connection.hpp"
 #include "http_body.hpp"
 #include "http_response.hpp"
 #include "http_utility.hpp"
 #include "logging.hpp"
 #include "mutual_tls.hpp"
+#include "sendfile.hpp"
 #include "ssl_key_handler.hpp"
 #include "str_utility.hpp"
 #include "utility.hpp"
 
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/_experimental/test/stream.hpp>
 #include <boost/beast/core/buffers_generator.hpp>
-#include <boost/beast/core/flat_static_buffer.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/message_generator.hpp>
 #include <boost/beast/http/parser.hpp>
 #include <boost/beast/http/read.hpp>
+#include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/write.hpp>
 #include <boost/beast/websocket.hpp>
 
+#include <unistd.h>
+
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace crow
 {
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-static int connectionCount = 0;
+static std::atomic<int> connectionCount = 0;
 
 // request body limit size set by the BMCWEB_HTTP_BODY_LIMIT option
 constexpr uint64_t httpReqBodyLimit = 1024UL * 1024UL * BMCWEB_HTTP_BODY_LIMIT;
@@ -46,6 +57,10 @@ constexpr uint64_t loggedOutPostBodyLimit = 4096U;
 
 constexpr uint32_t httpHeaderLimit = 8192U;
 
+// The read buffer starts out large enough for a full set of headers, and may
+// grow up to this size while reading bodies
+constexpr size_t httpReadBufferLimit = 64UL * 1024UL;
+
 template <typename>
 struct IsTls : std::false_type
 {};
@@ -61,13 +76,19 @@ class Connection :
     using self_type = Connection<Adaptor, Handler>;
 
   public:
+    // The socket and timer belong to the io_context that runs the
+    // connection's own work:  TLS, parsing the request, and serializing the
+    // response.  mainExecutorIn runs everything the handlers touch, and the
+    // connection posts to it to authenticate and handle each request.
     Connection(Handler* handlerIn, boost::asio::steady_timer&& timerIn,
                std::function<std::string()>& getCachedDateStrF,
-               Adaptor adaptorIn) :
+               Adaptor adaptorIn, boost::asio::any_io_executor mainExecutorIn) :
         adaptor(std::move(adaptorIn)),
-        handler(handlerIn), timer(std::move(timerIn)),
+        handler(handlerIn), executor(adaptor.get_executor()),
+        mainExecutor(std::move(mainExecutorIn)), timer(std::move(timerIn)),
         getCachedDateStr(getCachedDateStrF)
     {
+        buffer.reserve(httpHeaderLimit);
         initParser();
 
         if constexpr (BMCWEB_MUTUAL_TLS_AUTH)
@@ -78,7 +99,7 @@ class Connection :
         connectionCount++;
 
         BMCWEB_LOG_DEBUG("{} Connection created, total {}", logPtr(this),
-                         connectionCount);
+                         connectionCount.load());
     }
 
     ~Connection()
@@ -86,9 +107,11 @@ class Connection :
         res.releaseCompleteRequestHandler();
         cancelDeadlineTimer();
 
+        releaseAdmission();
+
         connectionCount--;
         BMCWEB_LOG_DEBUG("{} Connection closed, total {}", logPtr(this),
-                         connectionCount);
+                         connectionCount.load());
     }
 
     Connection(const Connection&) = delete;
@@ -103,14 +126,33 @@ class Connection :
         // don't require auth
         if (preverified)
         {
-            mtlsSession = verifyMtlsUser(ip, ctx);
+            // The handshake may be running on a connection thread, so the
+            // session is created later, when the first request is
+            // authenticated
+            mtlsUserName = getMtlsUserName(ctx);
+        }
+        return true;
+    }
+
+    // Runs on the adaptor's io_context, which owns the session store
+    void createPendingMtlsSession()
+    {
+        if (!mtlsUserName)
+        {
+            return;
+        }
+        if (persistent_data::SessionStore::getInstance()
+                .getAuthMethodsConfig()
+                .tls)
+        {
+            mtlsSession = createMtlsSession(ip, *mtlsUserName);
             if (mtlsSession)
             {
                 BMCWEB_LOG_DEBUG("{} Generating TLS session: {}", logPtr(this),
                                  mtlsSession->uniqueId);
             }
         }
-        return true;
+        mtlsUserName.reset();
     }
 
     void prepareMutualTls()
@@ -150,34 +192,121 @@ class Connection :
         return adaptor;
     }
 
+    const boost::asio::any_io_executor& getExecutor() const
+    {
+        return executor;
+    }
+
     void start()
     {
         BMCWEB_LOG_DEBUG("{} Connection started, total {}", logPtr(this),
-                         connectionCount);
-        if (connectionCount >= 200)
+                         connectionCount.load());
+
+        readClientIp();
+
+        std::weak_ptr<self_type> weakSelf = weak_from_this();
+        admission = AdmissionController::getInstance().admit(
+            ip, admissionTicket, [weakSelf]() {
+            std::shared_ptr<self_type> self = weakSelf.lock();
+            if (!self)
+            {
+                return;
+            }
+            boost::asio::post(self->executor,
+                              [self]() { self->afterAdmitted(); });
+        });
+        switch (admission)
         {
-            BMCWEB_LOG_CRITICAL("{} Max connection count exceeded.",
-                                logPtr(this));
-            return;
+            case AdmissionController::Decision::Admit:
+            case AdmissionController::Decision::Reject:
+                beginServing();
+                return;
+            case AdmissionController::Decision::Queue:
+                waitForAdmission();
+                return;
+            case AdmissionController::Decision::Drop:
+                BMCWEB_LOG_CRITICAL("{} Max connection count exceeded.",
+                                    logPtr(this));
+                return;
         }
+    }
 
-        startDeadline();
+    // Holds the connection, without reading from it, until the admission
+    // controller frees up a slot or gives up on it
+    void waitForAdmission()
+    {
+        BMCWEB_LOG_DEBUG("{} Waiting for a connection slot", logPtr(this));
+        timer.expires_after(AdmissionController::queueTimeout);
+        timer.async_wait(boost::asio::bind_executor(
+            executor, [self(shared_from_this())](
+                          const boost::system::error_code& ec) {
+            if (ec == boost::asio::error::operation_aborted)
+            {
+                return;
+            }
+            self->admission =
+                AdmissionController::getInstance().cancel(
+                    self->admissionTicket);
+            if (self->admission == AdmissionController::Decision::Admit)
+            {
+                // Admitted just as the wait ran out; afterAdmitted is already
+                // on its way
+                return;
+            }
+            BMCWEB_LOG_WARNING("{} Timed out waiting for a connection slot",
+                               logPtr(self.get()));
+            if (self->admission == AdmissionController::Decision::Reject)
+            {
+                self->beginServing();
+            }
+        }));
+    }
 
-        readClientIp();
+    void releaseAdmission()
+    {
+        AdmissionController& controller = AdmissionController::getInstance();
+        if (admission == AdmissionController::Decision::Queue)
+        {
+            admission = controller.cancel(admissionTicket);
+        }
+        if (admission == AdmissionController::Decision::Admit)
+        {
+            controller.release(ip);
+        }
+        else if (admission == AdmissionController::Decision::Reject)
+        {
+            controller.rejectDone();
+        }
+        admission = AdmissionController::Decision::Drop;
+    }
+
+    void afterAdmitted()
+    {
+        BMCWEB_LOG_DEBUG("{} Admitted from the queue", logPtr(this));
+        admission = AdmissionController::Decision::Admit;
+        timer.cancel();
+        beginServing();
+    }
+
+    void beginServing()
+    {
+        startDeadline();
 
         // TODO(ed) Abstract this to a more clever class with the idea of an
         // asynchronous "start"
         if constexpr (IsTls<Adaptor>::value)
         {
-            adaptor.async_handshake(boost::asio::ssl::stream_base::server,
-                                    [this, self(shared_from_this())](
-                                        const boost::system::error_code& ec) {
+            adaptor.async_handshake(
+                boost::asio::ssl::stream_base::server,
+                boost::asio::bind_executor(
+                    executor, [this, self(shared_from_this())](
+                                  const boost::system::error_code& ec) {
                 if (ec)
                 {
                     return;
                 }
                 afterSslHandshake();
-            });
+            }));
         }
         else
         {
@@ -201,10 +330,20 @@ class Connection :
                                  selectedProtocol, alpnlen);
                 if (selectedProtocol == "h2")
                 {
+                    if (admission == AdmissionController::Decision::Reject)
+                    {
+                        // Only HTTP/1 clients are sent a 503
+                        gracefulClose();
+                        return;
+                    }
+                    // HTTP/2 connections run entirely on the main
+                    // io_context, alongside the handlers
+                    moveToMain();
                     auto http2 =
                         std::make_shared<HTTP2Connection<Adaptor, Handler>>(
                             std::move(adaptor), handler, getCachedDateStr);
-                    http2->start();
+                    boost::asio::dispatch(mainExecutor,
+                                          [http2]() { http2->start(); });
                     return;
                 }
             }
@@ -228,19 +367,6 @@ class Connection :
 
     void handle()
     {
-        std::error_code reqEc;
-        if (!parser)
-        {
-            return;
-        }
-        req = std::make_shared<crow::Request>(parser->release(), reqEc);
-        if (reqEc)
-        {
-            BMCWEB_LOG_DEBUG("Request failed to construct{}", reqEc.message());
-            res.result(boost::beast::http::status::bad_request);
-            completeRequest(res);
-            return;
-        }
         req->session = userSession;
 
         // Fetch the client IP address
@@ -263,14 +389,13 @@ class Connection :
                         req->ipAddress.to_string());
 
         req->ioService = static_cast<decltype(req->ioService)>(
-            &adaptor.get_executor().context());
+            &mainExecutor.context());
 
         if (res.completed)
         {
             completeRequest(res);
             return;
         }
-        keepAlive = req->keepAlive();
         if constexpr (!std::is_same_v<Adaptor, boost::beast::test::stream>)
         {
             if constexpr (!BMCWEB_INSECURE_DISABLE_AUTH)
@@ -289,7 +414,7 @@ class Connection :
                 }
             }
         }
-        auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+        auto asyncResp = arena.makeShared<bmcweb::AsyncResp>();
         BMCWEB_LOG_DEBUG("Setting completion handler");
         asyncResp->res.setCompleteRequestHandler(
             [self(shared_from_this())](crow::Response& thisRes) {
@@ -354,13 +479,16 @@ class Connection :
         {
             BMCWEB_LOG_DEBUG("{} Removing TLS session: {}", logPtr(this),
                              mtlsSession->uniqueId);
-            persistent_data::SessionStore::getInstance().removeSession(
-                mtlsSession);
+            boost::asio::dispatch(mainExecutor, [session{mtlsSession}]() {
+                persistent_data::SessionStore::getInstance().removeSession(
+                    session);
+            });
         }
         if constexpr (IsTls<Adaptor>::value)
         {
-            adaptor.async_shutdown(std::bind_front(
-                &self_type::tlsShutdownComplete, this, shared_from_this()));
+            adaptor.async_shutdown(boost::asio::bind_executor(
+                executor, std::bind_front(&self_type::tlsShutdownComplete,
+                                          this, shared_from_this())));
         }
         else
         {
@@ -376,11 +504,15 @@ class Connection :
         completeResponseFields(*req, res);
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
 
-        doWrite();
-
         // delete lambda with self shared_ptr
         // to enable connection destruction
         res.setCompleteRequestHandler(nullptr);
+
+        // Writing the response is the connection's own work
+        boost::asio::dispatch(executor, [self(shared_from_this())]() {
+            self->handlingRequest = false;
+            self->doWrite();
+        });
     }
 
     void readClientIp()
@@ -478,79 +610,224 @@ class Connection :
             BMCWEB_LOG_CRITICAL("Parser was not initialized.");
             return;
         }
+        readingHeaders = true;
         // Clean up any previous Connection.
         boost::beast::http::async_read_header(
             adaptor, buffer, *parser,
-            [this,
-             self(shared_from_this())](const boost::system::error_code& ec,
-                                       std::size_t bytesTransferred) {
+            boost::asio::bind_executor(
+                executor,
+                [this,
+                 self(shared_from_this())](const boost::system::error_code& ec,
+                                           std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG("{} async_read_header {} Bytes", logPtr(this),
                              bytesTransferred);
-
-            if (ec)
+            readingHeaders = false;
+            if (responsePending)
             {
-                cancelDeadlineTimer();
-
-                if (ec == boost::beast::http::error::header_limit)
-                {
-                    BMCWEB_LOG_ERROR("{} Header field too large, closing",
-                                     logPtr(this), ec.message());
+                // A pipelined request;  it's picked up once the response to
+                // the previous one has been written
+                pendingHeaderRead = ec;
+                return;
+            }
+            afterReadHeaders(self, ec);
+        }));
+    }
 
-                    res.result(boost::beast::http::status::
-                                   request_header_fields_too_large);
-                    keepAlive = false;
-                    doWrite();
-                    return;
-                }
-                if (ec == boost::beast::http::error::end_of_stream)
-                {
-                    BMCWEB_LOG_WARNING("{} End of stream, closing {}",
-                                       logPtr(this), ec);
-                    hardClose();
-                    return;
-                }
+    void afterReadHeaders(const std::shared_ptr<self_type>& self,
+                          const boost::system::error_code& ec)
+    {
+        if (ec)
+        {
+            cancelDeadlineTimer();
 
-                BMCWEB_LOG_DEBUG("{} Closing socket due to read error {}",
+            if (ec == boost::beast::http::error::header_limit)
+            {
+                BMCWEB_LOG_ERROR("{} Header field too large, closing",
                                  logPtr(this), ec.message());
-                gracefulClose();
 
+                res.result(boost::beast::http::status::
+                               request_header_fields_too_large);
+                keepAlive = false;
+                doWrite();
                 return;
             }
-
-            if constexpr (!std::is_same_v<Adaptor, boost::beast::test::stream>)
+            if (ec == boost::beast::http::error::end_of_stream)
             {
-                if constexpr (!BMCWEB_INSECURE_DISABLE_AUTH)
-                {
-                    boost::beast::http::verb method = parser->get().method();
-                    userSession = crow::authentication::authenticate(
-                        ip, res, method, parser->get().base(), mtlsSession);
-                }
-            }
-
-            std::string_view expect =
-                parser->get()[boost::beast::http::field::expect];
-            if (bmcweb::asciiIEquals(expect, "100-continue"))
-            {
-                res.result(boost::beast::http::status::continue_);
-                doWrite();
+                BMCWEB_LOG_WARNING("{} End of stream, closing {}",
+                                   logPtr(this), ec);
+                hardClose();
                 return;
             }
 
-            if (!handleContentLengthError())
+            BMCWEB_LOG_DEBUG("{} Closing socket due to read error {}",
+                             logPtr(this), ec.message());
+            gracefulClose();
+
+            return;
+        }
+
+        if (admission == AdmissionController::Decision::Reject)
+        {
+            sendServiceUnavailable();
+            return;
+        }
+
+        if constexpr (!std::is_same_v<Adaptor, boost::beast::test::stream>)
+        {
+            if constexpr (!BMCWEB_INSECURE_DISABLE_AUTH)
             {
+                // Sessions belong to the main io_context
+                boost::asio::dispatch(
+                    mainExecutor,
+                    std::bind_front(&self_type::authenticate, this, self));
                 return;
             }
+        }
+        afterAuthenticate();
+    }
+
+    // Turns away a connection the admission controller had no room for.  The
+    // request headers have been read, so that closing the socket doesn't
+    // reset the connection before the client sees the response.
+    void sendServiceUnavailable()
+    {
+        res.result(boost::beast::http::status::service_unavailable);
+        res.addHeader(
+            boost::beast::http::field::retry_after,
+            std::to_string(AdmissionController::retryAfter.count()));
+        keepAlive = false;
+        res.keepAlive(false);
+        doWrite();
+    }
+
+    void authenticate(const std::shared_ptr<self_type>& self)
+    {
+        if constexpr (BMCWEB_MUTUAL_TLS_AUTH)
+        {
+            createPendingMtlsSession();
+        }
+        boost::beast::http::verb method = parser->get().method();
+        userSession = crow::authentication::authenticate(
+            ip, res, method, parser->get().base(), mtlsSession);
+
+        boost::asio::dispatch(executor,
+                              [self]() { self->afterAuthenticate(); });
+    }
 
-            parser->body_limit(getContentLengthLimit());
+    void afterAuthenticate()
+    {
+        std::string_view expect =
+            parser->get()[boost::beast::http::field::expect];
+        if (bmcweb::asciiIEquals(expect, "100-continue"))
+        {
+            res.result(boost::beast::http::status::continue_);
+            doWrite();
+            return;
+        }
 
-            if (parser->is_done())
+        if (!handleContentLengthError())
+        {
+            return;
+        }
+
+        parser->body_limit(getContentLengthLimit());
+
+        if (parser->is_done())
+        {
+            dispatchHandle();
+            return;
+        }
+
+        doRead();
+    }
+
+    // Hands the request over to the handlers, which run on the main
+    // io_context.  The connection is left alone until the response comes
+    // back, so the deadline can't be allowed to close the socket meanwhile.
+    void dispatchHandle()
+    {
+        cancelDeadlineTimer();
+        handlingRequest = true;
+        responsePending = true;
+
+        std::error_code reqEc;
+        req = arena.makeShared<crow::Request>(parser->release(), reqEc);
+        keepAlive = req->keepAlive();
+        if (reqEc)
+        {
+            BMCWEB_LOG_DEBUG("Request failed to construct{}", reqEc.message());
+            res.result(boost::beast::http::status::bad_request);
+            // Completing a response reads the server's date cache, which
+            // belongs to the main io_context
+            boost::asio::dispatch(mainExecutor, [self(shared_from_this())]() {
+                self->completeRequest(self->res);
+            });
+            return;
+        }
+
+        // Start reading the next request while this one is handled, so that
+        // pipelined requests don't wait for a round trip each.  Requests
+        // that can't be read ahead of may take the socket over, so it's
+        // moved to where their handler runs.
+        if (!canReadAhead())
+        {
+            moveToMain();
+        }
+        else if (keepAlive)
+        {
+            initParser();
+            doReadHeaders();
+        }
+
+        boost::asio::dispatch(mainExecutor,
+                              [self(shared_from_this())]() { self->handle(); });
+    }
+
+    // Re-registers the socket, and the timer, with the main io_context, for
+    // handlers that take the socket over from the connection.  Only called
+    // while nothing is pending on either.
+    void moveToMain()
+    {
+        if (executor == mainExecutor)
+        {
+            return;
+        }
+        if constexpr (!std::is_same_v<Adaptor, boost::beast::test::stream>)
+        {
+            boost::asio::ip::tcp::socket& socket =
+                boost::beast::get_lowest_layer(adaptor);
+            boost::system::error_code ec;
+            boost::asio::ip::tcp::endpoint endpoint =
+                socket.local_endpoint(ec);
+            boost::asio::ip::tcp::socket::native_handle_type fd =
+                socket.release(ec);
+            boost::asio::ip::tcp::socket moved(mainExecutor);
+            if (!ec)
             {
-                handle();
-                return;
+                moved.assign(endpoint.protocol(), fd, ec);
             }
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR("{} Failed to move socket: {}", logPtr(this),
+                                 ec.message());
+            }
+            socket = std::move(moved);
+        }
+        timer = boost::asio::steady_timer(mainExecutor);
+        executor = mainExecutor;
+    }
 
-            doRead();
-        });
+    bool canReadAhead() const
+    {
+        // Upgraded requests hand the socket over to their handler, which
+        // can't have a read pending on it
+        if (req->isUpgrade())
+        {
+            return false;
+        }
+        return !isContentTypeAllowed(req->getHeaderValue("Accept"),
+                                     http_helpers::ContentType::EventStream,
+                                     false);
     }
 
     void doRead()
@@ -563,9 +840,11 @@ class Connection :
         startDeadline();
         boost::beast::http::async_read_some(
             adaptor, buffer, *parser,
-            [this,
-             self(shared_from_this())](const boost::system::error_code& ec,
-                                       std::size_t bytesTransferred) {
+            boost::asio::bind_executor(
+                executor,
+                [this,
+                 self(shared_from_this())](const boost::system::error_code& ec,
+                                           std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG("{} async_read_some {} Bytes", logPtr(this),
                              bytesTransferred);
 
@@ -605,12 +884,11 @@ class Connection :
                 return;
             }
 
-            cancelDeadlineTimer();
-            handle();
-        });
+            dispatchHandle();
+        }));
     }
 
-    void afterDoWrite(const std::shared_ptr<self_type>& /*self*/,
+    void afterDoWrite(const std::shared_ptr<self_type>& self,
                       const boost::system::error_code& ec,
                       std::size_t bytesTransferred)
     {
@@ -618,6 +896,7 @@ class Connection :
                          bytesTransferred, ec);
 
         cancelDeadlineTimer();
+        fileSerializer = nullptr;
 
         if (ec == boost::system::errc::operation_would_block ||
             ec == boost::system::errc::resource_unavailable_try_again)
@@ -628,6 +907,11 @@ class Connection :
         if (ec)
         {
             BMCWEB_LOG_DEBUG("{} from write(2)", logPtr(this));
+            if (readingHeaders)
+            {
+                // Don't leave a pipelined read waiting on a broken connection
+                hardClose();
+            }
             return;
         }
 
@@ -650,25 +934,144 @@ class Connection :
 
         BMCWEB_LOG_DEBUG("{} Clearing response", logPtr(this));
         res.clear();
-        initParser();
 
         userSession = nullptr;
 
         req->clear();
+        responsePending = false;
+
+        // Give back memory that a large body needed once it's been consumed
+        if (buffer.size() == 0 && buffer.capacity() > httpHeaderLimit)
+        {
+            buffer.shrink_to_fit();
+            buffer.reserve(httpHeaderLimit);
+        }
+
+        if (pendingHeaderRead)
+        {
+            boost::system::error_code readEc = *pendingHeaderRead;
+            pendingHeaderRead.reset();
+            afterReadHeaders(self, readEc);
+            return;
+        }
+        if (readingHeaders)
+        {
+            // The next request is already being read
+            return;
+        }
+        initParser();
         doReadHeaders();
     }
 
+    // Returns the range of the body file to send with sendfile(2), if the
+    // response can bypass the userspace copy.  That requires the file to be
+    // sent byte for byte, with a length that is known up front.
+    std::optional<std::pair<off_t, size_t>> getSendFileRange()
+    {
+        bmcweb::HttpBody::value_type& body = res.response.body();
+        if (!body.file().is_open() || body.json() ||
+            body.encodingType != bmcweb::EncodingType::Raw ||
+            body.contentEncoding != bmcweb::ContentEncoding::Identity)
+        {
+            return std::nullopt;
+        }
+        std::optional<size_t> size = body.payloadSize();
+        if (!size || res.response.chunked())
+        {
+            return std::nullopt;
+        }
+        // These are sent without a body, see preparePayload()
+        if (boost::beast::http::to_status_class(res.result()) ==
+                boost::beast::http::status_class::informational ||
+            res.result() == boost::beast::http::status::no_content ||
+            res.result() == boost::beast::http::status::not_modified)
+        {
+            return std::nullopt;
+        }
+        off_t offset = lseek(body.file().native_handle(), 0, SEEK_CUR);
+        if (offset < 0 || static_cast<size_t>(offset) > *size)
+        {
+            return std::nullopt;
+        }
+        return std::make_pair(offset, *size - static_cast<size_t>(offset));
+    }
+
+    void doWriteFile(off_t offset, size_t length)
+    {
+        BMCWEB_LOG_DEBUG("{} Sending {} bytes of file with sendfile",
+                         logPtr(this), length);
+        fileSerializer = std::make_unique<
+            boost::beast::http::response_serializer<bmcweb::HttpBody>>(
+            res.response);
+        boost::beast::http::async_write_header(
+            adaptor, *fileSerializer,
+            boost::asio::bind_executor(
+                executor,
+                std::bind_front(&self_type::afterWriteFileHeader, this,
+                                shared_from_this(), offset, length)));
+    }
+
+    void afterWriteFileHeader(const std::shared_ptr<self_type>& self,
+                              off_t offset, size_t length,
+                              const boost::system::error_code& ec,
+                              std::size_t /*bytesTransferred*/)
+    {
+        if (ec)
+        {
+            afterDoWrite(self, ec, 0);
+            return;
+        }
+        bmcweb::asyncSendFile(
+            boost::beast::get_lowest_layer(adaptor),
+            res.response.body().file().native_handle(), offset, length,
+            boost::asio::bind_executor(
+                executor,
+                std::bind_front(&self_type::afterSendFile, this, self)));
+    }
+
+    void afterSendFile(const std::shared_ptr<self_type>& self,
+                       const boost::system::error_code& ec,
+                       std::size_t bytesTransferred)
+    {
+        if (bytesTransferred == 0 &&
+            (ec == boost::system::errc::invalid_argument ||
+             ec == boost::system::errc::function_not_supported))
+        {
+            // The file doesn't support sendfile.  The serializer has only
+            // written the header, so let it copy the body the normal way.
+            BMCWEB_LOG_DEBUG("{} sendfile unsupported, reading file instead",
+                             logPtr(this));
+            boost::beast::http::async_write(
+                adaptor, *fileSerializer,
+                boost::asio::bind_executor(
+                    executor,
+                    std::bind_front(&self_type::afterDoWrite, this, self)));
+            return;
+        }
+        afterDoWrite(self, ec, bytesTransferred);
+    }
+
     void doWrite()
     {
         BMCWEB_LOG_DEBUG("{} doWrite", logPtr(this));
         res.preparePayload();
 
         startDeadline();
+        if constexpr (std::is_same_v<Adaptor, boost::asio::ip::tcp::socket>)
+        {
+            std::optional<std::pair<off_t, size_t>> range = getSendFileRange();
+            if (range)
+            {
+                doWriteFile(range->first, range->second);
+                return;
+            }
+        }
         boost::beast::async_write(
             adaptor,
             boost::beast::http::message_generator(std::move(res.response)),
-            std::bind_front(&self_type::afterDoWrite, this,
-                            shared_from_this()));
+            boost::asio::bind_executor(
+                executor, std::bind_front(&self_type::afterDoWrite, this,
+                                          shared_from_this())));
     }
 
     void cancelDeadlineTimer()
@@ -688,7 +1091,8 @@ class Connection :
 
         std::weak_ptr<Connection<Adaptor, Handler>> weakSelf = weak_from_this();
         timer.expires_after(timeout);
-        timer.async_wait([weakSelf](const boost::system::error_code& ec) {
+        timer.async_wait(boost::asio::bind_executor(
+            executor, [weakSelf](const boost::system::error_code& ec) {
             // Note, we are ignoring other types of errors here;  If the timer
             // failed for any reason, we should still close the connection
             std::shared_ptr<Connection<Adaptor, Handler>> self =
@@ -720,11 +1124,18 @@ class Connection :
                                     ec);
             }
 
+            // The timer expired just as the request was handed over, too
+            // late for the cancel to catch it
+            if (self->handlingRequest)
+            {
+                return;
+            }
+
             BMCWEB_LOG_WARNING("{} Connection timed out, hard closing",
                                logPtr(self.get()));
 
             self->hardClose();
-        });
+        }));
 
         timerStarted = true;
         BMCWEB_LOG_DEBUG("{} timer started", logPtr(this));
@@ -732,6 +1143,10 @@ class Connection :
 
     Adaptor adaptor;
     Handler* handler;
+    // Runs the connection's own work;  the socket's io_context
+    boost::asio::any_io_executor executor;
+    // Runs authentication and the handlers
+    boost::asio::any_io_executor mainExecutor;
 
     boost::asio::ip::address ip;
 
@@ -739,13 +1154,21 @@ class Connection :
     // re-created on Connection reset
     std::optional<boost::beast::http::request_parser<bmcweb::HttpBody>> parser;
 
-    boost::beast::flat_static_buffer<8192> buffer;
+    boost::beast::flat_buffer buffer{httpReadBufferLimit};
 
+    // Recycles the memory of each request's Request and AsyncResp
+    bmcweb::ConnectionArena arena;
     std::shared_ptr<crow::Request> req;
     crow::Response res;
+    // Only used while sending a file body with sendfile;  refers to res, so it
+    // must be destroyed first
+    std::unique_ptr<boost::beast::http::response_serializer<bmcweb::HttpBody>>
+        fileSerializer;
 
     std::shared_ptr<persistent_data::UserSession> userSession;
     std::shared_ptr<persistent_data::UserSession> mtlsSession;
+    // Set during the TLS handshake;  the session is created from it later
+    std::optional<std::string> mtlsUserName;
 
     boost::asio::steady_timer timer;
 
@@ -753,6 +1176,24 @@ class Connection :
 
     bool timerStarted = false;
 
+    // Drop until start() asks the admission controller
+    AdmissionController::Decision admission =
+        AdmissionController::Decision::Drop;
+    // Identifies the connection while it's queued for admission
+    uint64_t admissionTicket = 0;
+
+    // Set while the handlers own the request, until the response is handed
+    // back to the connection to be written
+    bool handlingRequest = false;
+
+    // Set from when a request is handed to the handlers until its response
+    // has been written.  Pipelined requests wait for this to clear.
+    bool responsePending = false;
+    bool readingHeaders = false;
+    // Outcome of reading the headers of a pipelined request, held until the
+    // response to the previous request has been written
+    std::optional<boost::system::error_code> pendingHeaderRead;
+
     std::function<std::string()>& getCachedDateStr;
 
     using std::enable_shared_from_this<
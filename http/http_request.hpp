@@ -31,6 +31,12 @@ struct Request
     std::shared_ptr<persistent_data::UserSession> session;
 
     std::string userRole;
+
+    // Set on the subrequests made to $expand a response.  Their handlers only
+    // expand what they can themselves, and leave the rest to the request that
+    // made them.
+    bool expandSubrequest = false;
+
     Request(Body reqIn, std::error_code& ec) : req(std::move(reqIn))
     {
         if (!setUrlInfo())
@@ -69,6 +75,7 @@ struct Request
         ipAddress = boost::asio::ip::address();
         session = nullptr;
         userRole = "";
+        expandSubrequest = false;
     }
 
     boost::beast::http::verb method() const
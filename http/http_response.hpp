@@ -1,5 +1,6 @@
 #pragma once
 #include "http_body.hpp"
+#include "json_stream_serializer.hpp"
 #include "logging.hpp"
 #include "utils/hex_utils.hpp"
 
@@ -8,6 +9,8 @@
 #include <boost/beast/http/message.hpp>
 #include <nlohmann/json.hpp>
 
+#include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -230,6 +233,38 @@ struct Response
         response.body().str() = std::move(bodyPart);
     }
 
+    void setContentEncoding(bmcweb::ContentEncoding encoding)
+    {
+        response.body().contentEncoding = encoding;
+        addHeader(http::field::content_encoding, bmcweb::toString(encoding));
+    }
+
+    // Moves jsonValue into the body.  Documents that serialize to less than
+    // jsonStreamThreshold bytes are written out immediately so they keep a
+    // Content-Length.  Larger documents are serialized chunk by chunk as the
+    // body is written, unless the client can't accept a chunked response.
+    void writeJson(int indent, bool allowStreaming)
+    {
+        auto stream = std::make_shared<bmcweb::JsonStreamSerializer>(
+            std::move(jsonValue), indent);
+        jsonValue = nullptr;
+        if (allowStreaming)
+        {
+            stream->fill(jsonStreamThreshold);
+        }
+        else
+        {
+            stream->fill(std::numeric_limits<size_t>::max());
+        }
+        if (stream->isSerialized())
+        {
+            write(stream->release());
+            return;
+        }
+        BMCWEB_LOG_DEBUG("{} Streaming json response", logPtr(this));
+        response.body().setJson(std::move(stream));
+    }
+
     void end()
     {
         if (completed)
@@ -322,6 +357,9 @@ struct Response
     }
 
   private:
+    // Matches the read size of HttpBody::writer
+    static constexpr size_t jsonStreamThreshold = 1024UL * 64UL;
+
     std::optional<std::string> expectedHash;
     bool completed = false;
     std::function<void(Response&)> completeRequestHandler;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "http_connection.hpp"
+#include "io_shards.hpp"
 #include "logging.hpp"
 #include "ssl_key_handler.hpp"
 
@@ -35,7 +38,12 @@ class Server
         acceptor(std::move(acceptorIn)),
         signals(*ioService, SIGINT, SIGTERM, SIGHUP), handler(handlerIn),
         adaptorCtx(std::move(adaptorCtxIn))
-    {}
+    {
+        if constexpr (BMCWEB_HTTP_IO_THREADS > 1)
+        {
+            shards = std::make_unique<IoShards>(BMCWEB_HTTP_IO_THREADS);
+        }
+    }
 
     void updateDateStr()
     {
@@ -120,6 +128,10 @@ class Server
 
     void stop()
     {
+        if (shards != nullptr)
+        {
+            shards->stop();
+        }
         ioService->stop();
     }
 
@@ -130,7 +142,13 @@ class Server
             BMCWEB_LOG_CRITICAL("IoService was null");
             return;
         }
-        boost::asio::steady_timer timer(*ioService);
+        // The socket and its timer belong to the connection's shard, so
+        // that shard alone waits on it.  The main io_context, which owns
+        // everything the handlers touch, is passed for the connection to
+        // post requests to.
+        boost::asio::io_context& connectionIo =
+            shards != nullptr ? shards->next() : *ioService;
+        boost::asio::steady_timer timer(connectionIo);
         std::shared_ptr<Connection<Adaptor, Handler>> connection;
         if constexpr (std::is_same<Adaptor,
                                    boost::asio::ssl::stream<
@@ -144,20 +162,20 @@ class Server
             }
             connection = std::make_shared<Connection<Adaptor, Handler>>(
                 handler, std::move(timer), getCachedDateStr,
-                Adaptor(*ioService, *adaptorCtx));
+                Adaptor(connectionIo, *adaptorCtx), ioService->get_executor());
         }
         else
         {
             connection = std::make_shared<Connection<Adaptor, Handler>>(
                 handler, std::move(timer), getCachedDateStr,
-                Adaptor(*ioService));
+                Adaptor(connectionIo), ioService->get_executor());
         }
         acceptor.async_accept(
             boost::beast::get_lowest_layer(connection->socket()),
             [this, connection](const boost::system::error_code& ec) {
             if (!ec)
             {
-                boost::asio::post(*ioService,
+                boost::asio::post(connection->getExecutor(),
                                   [connection] { connection->start(); });
             }
             doAccept();
@@ -175,5 +193,7 @@ class Server
     Handler* handler;
 
     std::shared_ptr<boost::asio::ssl::context> adaptorCtx;
+
+    std::unique_ptr<IoShards> shards;
 };
 } // namespace crow
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace crow
+{
+
+// A set of io_contexts, each run by a thread of its own.  Connections are
+// handed out to them round robin, and their sockets are registered with the
+// shard's io_context, so that waiting on sockets and the CPU bound parts of
+// serving a connection (TLS, parsing requests, serializing and compressing
+// responses) are spread across cores instead of all sharing the main event
+// loop.
+class IoShards
+{
+  public:
+    explicit IoShards(size_t count)
+    {
+        shards.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            shards.emplace_back(std::make_unique<Shard>());
+        }
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            shard->thread = std::thread([&io = shard->io]() { io.run(); });
+        }
+        BMCWEB_LOG_INFO("Running connections on {} threads", count);
+    }
+
+    ~IoShards()
+    {
+        stop();
+    }
+
+    IoShards(const IoShards&) = delete;
+    IoShards(IoShards&&) = delete;
+    IoShards& operator=(const IoShards&) = delete;
+    IoShards& operator=(IoShards&&) = delete;
+
+    boost::asio::io_context& next()
+    {
+        Shard& shard = *shards[nextShard];
+        nextShard = (nextShard + 1) % shards.size();
+        return shard.io;
+    }
+
+    void stop()
+    {
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            shard->work.reset();
+            shard->io.stop();
+        }
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            if (shard->thread.joinable())
+            {
+                shard->thread.join();
+            }
+        }
+    }
+
+  private:
+    struct Shard
+    {
+        boost::asio::io_context io{1};
+        // Keeps run() from returning while the shard has no connections
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+            work{io.get_executor()};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t nextShard = 0;
+};
+
+} // namespace crow
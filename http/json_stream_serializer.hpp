@@ -0,0 +1,171 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bmcweb
+{
+
+// Serializes a json tree incrementally, producing exactly the same bytes as
+// nlohmann::json::dump(indent, ' ', true, error_handler_t::replace), but only
+// as far ahead as the consumer has asked for.  This allows large responses to
+// be handed to the socket piece by piece, without holding a fully serialized
+// copy of the body in memory alongside the tree it was built from.
+class JsonStreamSerializer
+{
+  public:
+    JsonStreamSerializer(nlohmann::json&& rootIn, int indentIn) :
+        root(std::move(rootIn)), pretty(indentIn >= 0),
+        indentStep(pretty ? static_cast<unsigned int>(indentIn) : 0U),
+        serializer(nlohmann::detail::output_adapter<char>(buf), ' ',
+                   nlohmann::json::error_handler_t::replace),
+        key(nlohmann::json::value_t::string)
+    {}
+
+    // The serializer holds pointers into both root and buf
+    JsonStreamSerializer(const JsonStreamSerializer&) = delete;
+    JsonStreamSerializer(JsonStreamSerializer&&) = delete;
+    JsonStreamSerializer& operator=(const JsonStreamSerializer&) = delete;
+    JsonStreamSerializer& operator=(JsonStreamSerializer&&) = delete;
+    ~JsonStreamSerializer() = default;
+
+    // Serializes until at least minSize bytes are pending, or until the whole
+    // tree has been written out.
+    void fill(size_t minSize)
+    {
+        if (offset != 0)
+        {
+            buf.erase(0, offset);
+            offset = 0;
+        }
+        while (buf.size() < minSize && !serialized)
+        {
+            step();
+        }
+    }
+
+    // Bytes that have been serialized, but not yet consumed
+    std::string_view pending() const
+    {
+        return std::string_view(buf).substr(offset);
+    }
+
+    void consume(size_t bytes)
+    {
+        offset = std::min(offset + bytes, buf.size());
+    }
+
+    // True once the entire tree has been serialized into the pending buffer
+    bool isSerialized() const
+    {
+        return serialized;
+    }
+
+    // Once fully serialized, hands over the remaining output, avoiding a copy
+    // for the common case where the tree fit within a single fill()
+    std::string release()
+    {
+        if (offset != 0)
+        {
+            buf.erase(0, offset);
+            offset = 0;
+        }
+        return std::move(buf);
+    }
+
+  private:
+    struct Frame
+    {
+        const nlohmann::json* container;
+        nlohmann::json::const_iterator it;
+        unsigned int indent;
+    };
+
+    void writeValue(const nlohmann::json& val, unsigned int indent)
+    {
+        if (val.is_structured() && !val.empty())
+        {
+            buf += val.is_object() ? '{' : '[';
+            if (pretty)
+            {
+                buf += '\n';
+            }
+            stack.push_back({&val, val.cbegin(), indent});
+            return;
+        }
+        serializer.dump(val, pretty, true, indentStep, indent);
+    }
+
+    void step()
+    {
+        if (stack.empty())
+        {
+            if (!started)
+            {
+                started = true;
+                writeValue(root, 0);
+            }
+            serialized = stack.empty();
+            return;
+        }
+
+        Frame& frame = stack.back();
+        if (frame.it == frame.container->cend())
+        {
+            char close = frame.container->is_object() ? '}' : ']';
+            if (pretty)
+            {
+                buf += '\n';
+                buf.append(frame.indent, ' ');
+            }
+            buf += close;
+            stack.pop_back();
+            serialized = stack.empty();
+            return;
+        }
+
+        unsigned int childIndent = frame.indent + indentStep;
+        if (frame.it != frame.container->cbegin())
+        {
+            buf += pretty ? ",\n" : ",";
+        }
+        if (pretty)
+        {
+            buf.append(childIndent, ' ');
+        }
+        if (frame.container->is_object())
+        {
+            // Reuse a single string value so that keys get identical escaping
+            // to values without allocating on every member
+            *key.get_ptr<std::string*>() = frame.it.key();
+            serializer.dump(key, false, true, 0);
+            buf += pretty ? ": " : ":";
+        }
+        const nlohmann::json& child = *frame.it;
+        ++frame.it;
+        // Note, frame is invalidated after this call if child is pushed
+        writeValue(child, childIndent);
+    }
+
+    nlohmann::json root;
+    bool pretty;
+    unsigned int indentStep;
+
+    std::string buf;
+    size_t offset = 0;
+
+    nlohmann::detail::serializer<nlohmann::json> serializer;
+    nlohmann::json key;
+
+    std::vector<Frame> stack;
+    bool started = false;
+    bool serialized = false;
+};
+
+} // namespace bmcweb
@@ -14,26 +14,22 @@ extern "C"
 #include <boost/asio/ssl/verify_context.hpp>
 
 #include <memory>
+#include <optional>
 #include <span>
-
-inline std::shared_ptr<persistent_data::UserSession>
-    verifyMtlsUser(const boost::asio::ip::address& clientIp,
-                   boost::asio::ssl::verify_context& ctx)
+#include <string>
+
+// Returns the user named by the client certificate being verified, once
+// verification has reached the end of the chain.  This only inspects the
+// certificate, so unlike creating the session, it is safe to call from
+// whichever thread is running the TLS handshake.
+inline std::optional<std::string>
+    getMtlsUserName(boost::asio::ssl::verify_context& ctx)
 {
-    // do nothing if TLS is disabled
-    if (!persistent_data::SessionStore::getInstance()
-             .getAuthMethodsConfig()
-             .tls)
-    {
-        BMCWEB_LOG_DEBUG("TLS auth_config is disabled");
-        return nullptr;
-    }
-
     X509_STORE_CTX* cts = ctx.native_handle();
     if (cts == nullptr)
     {
         BMCWEB_LOG_DEBUG("Cannot get native TLS handle.");
-        return nullptr;
+        return std::nullopt;
     }
 
     // Get certificate
@@ -41,7 +37,7 @@ inline std::shared_ptr<persistent_data::UserSession>
     if (peerCert == nullptr)
     {
         BMCWEB_LOG_DEBUG("Cannot get current TLS certificate.");
-        return nullptr;
+        return std::nullopt;
     }
 
     // Check if certificate is OK
@@ -49,7 +45,7 @@ inline std::shared_ptr<persistent_data::UserSession>
     if (ctxError != X509_V_OK)
     {
         BMCWEB_LOG_INFO("Last TLS error is: {}", ctxError);
-        return nullptr;
+        return std::nullopt;
     }
 
     // Check that we have reached final certificate in chain
@@ -59,7 +55,7 @@ inline std::shared_ptr<persistent_data::UserSession>
         BMCWEB_LOG_DEBUG(
             "Certificate verification in progress (depth {}), waiting to reach final depth",
             depth);
-        return nullptr;
+        return std::nullopt;
     }
 
     BMCWEB_LOG_DEBUG("Certificate verification of final depth");
@@ -68,7 +64,7 @@ inline std::shared_ptr<persistent_data::UserSession>
     {
         BMCWEB_LOG_DEBUG(
             "Chain does not allow certificate to be used for SSL client authentication");
-        return nullptr;
+        return std::nullopt;
     }
 
     std::string sslUser;
@@ -82,14 +78,14 @@ inline std::shared_ptr<persistent_data::UserSession>
     if (status == -1)
     {
         BMCWEB_LOG_DEBUG("TLS cannot get username to create session");
-        return nullptr;
+        return std::nullopt;
     }
 
     size_t lastChar = sslUser.find('\0');
     if (lastChar == std::string::npos || lastChar == 0)
     {
         BMCWEB_LOG_DEBUG("Invalid TLS user name");
-        return nullptr;
+        return std::nullopt;
     }
     sslUser.resize(lastChar);
 
@@ -100,13 +96,41 @@ inline std::shared_ptr<persistent_data::UserSession>
             mtlsMetaParseSslUser(sslUser);
         if (!sslUserMeta)
         {
-            return nullptr;
+            return std::nullopt;
         }
         sslUser = *sslUserMeta;
     }
 
+    return sslUser;
+}
+
+inline std::shared_ptr<persistent_data::UserSession>
+    createMtlsSession(const boost::asio::ip::address& clientIp,
+                      const std::string& sslUser)
+{
     std::string unsupportedClientId;
     return persistent_data::SessionStore::getInstance().generateUserSession(
         sslUser, clientIp, unsupportedClientId,
         persistent_data::PersistenceType::TIMEOUT);
 }
+
+inline std::shared_ptr<persistent_data::UserSession>
+    verifyMtlsUser(const boost::asio::ip::address& clientIp,
+                   boost::asio::ssl::verify_context& ctx)
+{
+    // do nothing if TLS is disabled
+    if (!persistent_data::SessionStore::getInstance()
+             .getAuthMethodsConfig()
+             .tls)
+    {
+        BMCWEB_LOG_DEBUG("TLS auth_config is disabled");
+        return nullptr;
+    }
+
+    std::optional<std::string> sslUser = getMtlsUserName(ctx);
+    if (!sslUser)
+    {
+        return nullptr;
+    }
+    return createMtlsSession(clientIp, *sslUser);
+}
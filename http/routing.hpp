@@ -23,26 +23,62 @@
 #include <boost/container/small_vector.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
-#include <tuple>
 #include <utility>
 #include <vector>
 
 namespace crow
 {
 
+// Methods bitfield with a bit set for every verb
+constexpr size_t allMethodsBitfield = (1U << (maxVerbIndex + 1U)) - 1U;
+
+// The Allow header listing the verbs set in a methods bitfield.  Every
+// combination is built once, so that lookups never need to allocate one.
+inline std::string_view allowHeaderForMethods(size_t methods)
+{
+    static const std::array<std::string, allMethodsBitfield + 1U> headers =
+        []() {
+        std::array<std::string, allMethodsBitfield + 1U> ret;
+        for (size_t bitfield = 0; bitfield <= allMethodsBitfield; bitfield++)
+        {
+            for (size_t method = 0; method <= maxVerbIndex; method++)
+            {
+                if ((bitfield & (1U << method)) == 0U)
+                {
+                    continue;
+                }
+                if (!ret[bitfield].empty())
+                {
+                    ret[bitfield] += ", ";
+                }
+                ret[bitfield] +=
+                    httpVerbToString(static_cast<HttpVerb>(method));
+            }
+        }
+        return ret;
+    }();
+    return headers[methods & allMethodsBitfield];
+}
+
 class Trie
 {
   public:
     struct Node
     {
-        unsigned ruleIndex = 0U;
+        // The rule registered for each verb at this node, 0 where there is
+        // none
+        std::array<unsigned, maxVerbIndex + 1U> ruleIndexes{};
+        // Bit n is set when ruleIndexes[n] holds a rule
+        size_t methods = 0U;
 
         size_t stringParamChild = 0U;
         size_t pathParamChild = 0U;
@@ -55,7 +91,7 @@ class Trie
 
         bool isSimpleNode() const
         {
-            return ruleIndex == 0 && stringParamChild == 0 &&
+            return methods == 0U && stringParamChild == 0 &&
                    pathParamChild == 0;
         }
     };
@@ -133,9 +169,17 @@ class Trie
             const Node& child = nodes[kv.second];
             if (reqUrl.empty())
             {
-                if (child.ruleIndex != 0 && fragment != "/")
+                if (fragment != "/")
                 {
-                    routeIndexes.push_back(child.ruleIndex);
+                    for (unsigned ruleIndex : child.ruleIndexes)
+                    {
+                        if (ruleIndex != 0U &&
+                            std::ranges::find(routeIndexes, ruleIndex) ==
+                                routeIndexes.end())
+                        {
+                            routeIndexes.push_back(ruleIndex);
+                        }
+                    }
                 }
                 findRouteIndexesHelper(reqUrl, routeIndexes, child);
             }
@@ -156,19 +200,33 @@ class Trie
         findRouteIndexesHelper(reqUrl, routeIndexes, head());
     }
 
+    // Parameters captured from the url, as views into it
+    using Params = boost::container::small_vector<std::string_view, 5>;
+
     struct FindResult
     {
-        unsigned ruleIndex;
-        std::vector<std::string> params;
+        // The rule matched for the requested verb, 0 if there was none
+        unsigned ruleIndex = 0U;
+        Params params;
+        // Every verb that has a rule matching the url
+        size_t methods = 0U;
     };
 
   private:
-    FindResult findHelper(const std::string_view reqUrl, const Node& node,
-                          std::vector<std::string>& params) const
+    // Visits every node that matches the whole url, in order of precedence.
+    // For each verb, the first node with a rule for it is that verb's route.
+    void findHelper(std::string_view reqUrl, const Node& node, size_t method,
+                    Params& params, FindResult& result) const
     {
         if (reqUrl.empty())
         {
-            return {node.ruleIndex, params};
+            if (result.ruleIndex == 0U && node.ruleIndexes[method] != 0U)
+            {
+                result.ruleIndex = node.ruleIndexes[method];
+                result.params = params;
+            }
+            result.methods |= node.methods;
+            return;
         }
 
         if (node.stringParamChild != 0U)
@@ -185,12 +243,8 @@ class Trie
             if (epos != 0)
             {
                 params.emplace_back(reqUrl.substr(0, epos));
-                FindResult ret = findHelper(
-                    reqUrl.substr(epos), nodes[node.stringParamChild], params);
-                if (ret.ruleIndex != 0U)
-                {
-                    return {ret.ruleIndex, std::move(ret.params)};
-                }
+                findHelper(reqUrl.substr(epos), nodes[node.stringParamChild],
+                           method, params, result);
                 params.pop_back();
             }
         }
@@ -198,11 +252,7 @@ class Trie
         if (node.pathParamChild != 0U)
         {
             params.emplace_back(reqUrl);
-            FindResult ret = findHelper("", nodes[node.pathParamChild], params);
-            if (ret.ruleIndex != 0U)
-            {
-                return {ret.ruleIndex, std::move(ret.params)};
-            }
+            findHelper("", nodes[node.pathParamChild], method, params, result);
             params.pop_back();
         }
 
@@ -213,26 +263,25 @@ class Trie
 
             if (reqUrl.starts_with(fragment))
             {
-                FindResult ret = findHelper(reqUrl.substr(fragment.size()),
-                                            child, params);
-                if (ret.ruleIndex != 0U)
-                {
-                    return {ret.ruleIndex, std::move(ret.params)};
-                }
+                findHelper(reqUrl.substr(fragment.size()), child, method,
+                           params, result);
             }
         }
-
-        return {0U, std::vector<std::string>()};
     }
 
   public:
-    FindResult find(const std::string_view reqUrl) const
+    // Finds the rule for one verb, along with every verb the url could be
+    // used with, in a single walk of the tree
+    FindResult find(const std::string_view reqUrl, size_t method) const
     {
-        std::vector<std::string> start;
-        return findHelper(reqUrl, head(), start);
+        FindResult result;
+        Params params;
+        findHelper(reqUrl, head(), method, params, result);
+        return result;
     }
 
-    void add(std::string_view urlIn, unsigned ruleIndex)
+    // Registers ruleIndex for each verb in methods
+    void add(std::string_view urlIn, unsigned ruleIndex, size_t methods)
     {
         size_t idx = 0;
 
@@ -285,19 +334,31 @@ class Trie
             url.remove_prefix(1);
         }
         Node& node = nodes[idx];
-        if (node.ruleIndex != 0U)
+        if ((node.methods & methods) != 0U)
         {
             BMCWEB_LOG_CRITICAL("handler already exists for \"{}\"", urlIn);
             throw std::runtime_error(
                 std::format("handler already exists for \"{}\"", urlIn));
         }
-        node.ruleIndex = ruleIndex;
+        for (size_t method = 0; method <= maxVerbIndex; method++)
+        {
+            if ((methods & (1U << method)) != 0U)
+            {
+                node.ruleIndexes[method] = ruleIndex;
+            }
+        }
+        node.methods |= methods;
     }
 
   private:
     void debugNodePrint(Node& n, size_t level)
     {
         std::string spaces(level, ' ');
+        if (n.methods != 0U)
+        {
+            BMCWEB_LOG_DEBUG("{}[{}]", spaces,
+                             allowHeaderForMethods(n.methods));
+        }
         if (n.stringParamChild != 0U)
         {
             BMCWEB_LOG_DEBUG("{}<str>", spaces);
@@ -412,24 +473,25 @@ class Router
         static_assert(NumArgs <= 5, "Max number of args supported is 5");
     }
 
-    struct PerMethod
+    struct RouteTable
     {
         std::vector<BaseRule*> rules;
         Trie trie;
         // rule index 0 has special meaning; preallocate it to avoid
         // duplication.
-        PerMethod() : rules(1) {}
+        RouteTable() : rules(1) {}
 
-        void internalAdd(std::string_view rule, BaseRule* ruleObject)
+        void internalAdd(std::string_view rule, BaseRule* ruleObject,
+                         size_t methods)
         {
             rules.emplace_back(ruleObject);
-            trie.add(rule, static_cast<unsigned>(rules.size() - 1U));
+            trie.add(rule, static_cast<unsigned>(rules.size() - 1U), methods);
             // directory case:
             //   request to `/about' url matches `/about/' rule
             if (rule.size() > 2 && rule.back() == '/')
             {
                 trie.add(rule.substr(0, rule.size() - 1),
-                         static_cast<unsigned>(rules.size() - 1));
+                         static_cast<unsigned>(rules.size() - 1), methods);
             }
         }
     };
@@ -440,33 +502,40 @@ class Router
         {
             return;
         }
-        for (size_t method = 0; method <= maxVerbIndex; method++)
+        if (ruleObject->methodsBitfield != 0U)
         {
-            size_t methodBit = 1 << method;
-            if ((ruleObject->methodsBitfield & methodBit) > 0U)
-            {
-                perMethods[method].internalAdd(rule, ruleObject);
-            }
+            routes.internalAdd(rule, ruleObject,
+                               ruleObject->methodsBitfield &
+                                   allMethodsBitfield);
         }
 
+        // The fallback routes apply whatever the verb
         if (ruleObject->isNotFound)
         {
-            notFoundRoutes.internalAdd(rule, ruleObject);
+            notFoundRoutes.internalAdd(rule, ruleObject, allMethodsBitfield);
         }
 
         if (ruleObject->isMethodNotAllowed)
         {
-            methodNotAllowedRoutes.internalAdd(rule, ruleObject);
+            methodNotAllowedRoutes.internalAdd(rule, ruleObject,
+                                               allMethodsBitfield);
         }
 
         if (ruleObject->isUpgrade)
         {
-            upgradeRoutes.internalAdd(rule, ruleObject);
+            upgradeRoutes.internalAdd(rule, ruleObject, allMethodsBitfield);
         }
     }
 
     void validate()
     {
+        // Build the index from scratch, so that validating again after adding
+        // more rules doesn't register the earlier ones twice
+        routes = RouteTable();
+        notFoundRoutes = RouteTable();
+        upgradeRoutes = RouteTable();
+        methodNotAllowedRoutes = RouteTable();
+
         for (std::unique_ptr<BaseRule>& rule : allRules)
         {
             if (rule)
@@ -480,38 +549,40 @@ class Router
                 internalAddRuleObject(rule->rule, rule.get());
             }
         }
-        for (PerMethod& perMethod : perMethods)
-        {
-            perMethod.trie.validate();
-        }
+        routes.trie.validate();
+        notFoundRoutes.trie.validate();
+        upgradeRoutes.trie.validate();
+        methodNotAllowedRoutes.trie.validate();
     }
 
     struct FindRoute
     {
         BaseRule* rule = nullptr;
-        std::vector<std::string> params;
+        // Views into the url of the request that was looked up
+        Trie::Params params;
     };
 
     struct FindRouteResponse
     {
-        std::string allowHeader;
+        std::string_view allowHeader;
         FindRoute route;
     };
 
-    static FindRoute findRouteByPerMethod(std::string_view url,
-                                          const PerMethod& perMethod)
+    static FindRoute findRouteByTable(std::string_view url, HttpVerb verb,
+                                      const RouteTable& table)
     {
         FindRoute route;
 
-        Trie::FindResult found = perMethod.trie.find(url);
-        if (found.ruleIndex >= perMethod.rules.size())
+        Trie::FindResult found =
+            table.trie.find(url, static_cast<size_t>(verb));
+        if (found.ruleIndex >= table.rules.size())
         {
             throw std::runtime_error("Trie internal structure corrupted!");
         }
         // Found a 404 route, switch that in
         if (found.ruleIndex != 0U)
         {
-            route.rule = perMethod.rules[found.ruleIndex];
+            route.rule = table.rules[found.ruleIndex];
             route.params = std::move(found.params);
         }
         return route;
@@ -526,30 +597,19 @@ class Router
         {
             return findRoute;
         }
-        size_t reqMethodIndex = static_cast<size_t>(*verb);
-        // Check to see if this url exists at any verb
-        for (size_t perMethodIndex = 0; perMethodIndex <= maxVerbIndex;
-             perMethodIndex++)
-        {
-            // Make sure it's safe to deference the array at that index
-            static_assert(maxVerbIndex <
-                          std::tuple_size_v<decltype(perMethods)>);
-            FindRoute route = findRouteByPerMethod(req.url().encoded_path(),
-                                                   perMethods[perMethodIndex]);
-            if (route.rule == nullptr)
-            {
-                continue;
-            }
-            if (!findRoute.allowHeader.empty())
-            {
-                findRoute.allowHeader += ", ";
-            }
-            HttpVerb thisVerb = static_cast<HttpVerb>(perMethodIndex);
-            findRoute.allowHeader += httpVerbToString(thisVerb);
-            if (perMethodIndex == reqMethodIndex)
-            {
-                findRoute.route = route;
-            }
+        // One walk finds both the route for this verb, and every verb the
+        // url exists at for the Allow header
+        Trie::FindResult found = routes.trie.find(req.url().encoded_path(),
+                                                  static_cast<size_t>(*verb));
+        if (found.ruleIndex >= routes.rules.size())
+        {
+            throw std::runtime_error("Trie internal structure corrupted!");
+        }
+        findRoute.allowHeader = allowHeaderForMethods(found.methods);
+        if (found.ruleIndex != 0U)
+        {
+            findRoute.route.rule = routes.rules[found.ruleIndex];
+            findRoute.route.params = std::move(found.params);
         }
         return findRoute;
     }
@@ -559,13 +619,10 @@ class Router
                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                        Adaptor&& adaptor)
     {
-        PerMethod& perMethod = upgradeRoutes;
-        Trie& trie = perMethod.trie;
-        std::vector<BaseRule*>& rules = perMethod.rules;
-
-        Trie::FindResult found = trie.find(req->url().encoded_path());
-        unsigned ruleIndex = found.ruleIndex;
-        if (ruleIndex == 0U)
+        // Upgrade routes are registered for every verb
+        FindRoute found = findRouteByTable(req->url().encoded_path(),
+                                           HttpVerb::Get, upgradeRoutes);
+        if (found.rule == nullptr)
         {
             BMCWEB_LOG_DEBUG("Cannot match rules {}",
                              req->url().encoded_path());
@@ -573,12 +630,7 @@ class Router
             return;
         }
 
-        if (ruleIndex >= rules.size())
-        {
-            throw std::runtime_error("Trie internal structure corrupted!");
-        }
-
-        BaseRule& rule = *rules[ruleIndex];
+        BaseRule& rule = *found.rule;
 
         BMCWEB_LOG_DEBUG("Matched rule (upgrade) '{}'", rule.rule);
 
@@ -595,7 +647,7 @@ class Router
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
     {
         std::optional<HttpVerb> verb = httpVerbFromBoost(req->method());
-        if (!verb || static_cast<size_t>(*verb) >= perMethods.size())
+        if (!verb)
         {
             asyncResp->res.result(boost::beast::http::status::not_found);
             return;
@@ -609,14 +661,14 @@ class Router
             // route
             if (foundRoute.allowHeader.empty())
             {
-                foundRoute.route = findRouteByPerMethod(
-                    req->url().encoded_path(), notFoundRoutes);
+                foundRoute.route = findRouteByTable(req->url().encoded_path(),
+                                                    *verb, notFoundRoutes);
             }
             else
             {
                 // See if we have a method not allowed (405) handler
-                foundRoute.route = findRouteByPerMethod(
-                    req->url().encoded_path(), methodNotAllowedRoutes);
+                foundRoute.route = findRouteByTable(
+                    req->url().encoded_path(), *verb, methodNotAllowedRoutes);
             }
         }
 
@@ -644,54 +696,65 @@ class Router
         }
 
         BaseRule& rule = *foundRoute.route.rule;
-        std::vector<std::string> params = std::move(foundRoute.route.params);
+        // The views point into the url, which req keeps alive, so they're
+        // only copied out for the handler once it's known to run
+        Trie::Params params = std::move(foundRoute.route.params);
 
         BMCWEB_LOG_DEBUG("Matched rule '{}' {} / {}", rule.rule,
                          static_cast<uint32_t>(*verb), rule.getMethods());
 
         if (req->session == nullptr)
         {
-            rule.handle(*req, asyncResp, params);
+            rule.handle(*req, asyncResp,
+                        std::vector<std::string>(params.begin(), params.end()));
             return;
         }
         validatePrivilege(
             req, asyncResp, rule,
             [req, asyncResp, &rule, params = std::move(params)]() {
-            rule.handle(*req, asyncResp, params);
+            rule.handle(*req, asyncResp,
+                        std::vector<std::string>(params.begin(), params.end()));
         });
     }
 
     void debugPrint()
     {
-        for (size_t i = 0; i < perMethods.size(); i++)
-        {
-            BMCWEB_LOG_DEBUG("{}", httpVerbToString(static_cast<HttpVerb>(i)));
-            perMethods[i].trie.debugPrint();
-        }
+        routes.trie.debugPrint();
     }
 
     std::vector<const std::string*> getRoutes(const std::string& parent)
     {
         std::vector<const std::string*> ret;
 
-        for (const PerMethod& pm : perMethods)
+        std::vector<unsigned> x;
+        routes.trie.findRouteIndexes(parent, x);
+        for (unsigned index : x)
+        {
+            ret.push_back(&routes.rules[index]->rule);
+        }
+        return ret;
+    }
+
+    std::vector<const BaseRule*> getAllRules() const
+    {
+        std::vector<const BaseRule*> ret;
+        for (const std::unique_ptr<BaseRule>& rule : allRules)
         {
-            std::vector<unsigned> x;
-            pm.trie.findRouteIndexes(parent, x);
-            for (unsigned index : x)
+            if (rule)
             {
-                ret.push_back(&pm.rules[index]->rule);
+                ret.push_back(rule.get());
             }
         }
         return ret;
     }
 
   private:
-    std::array<PerMethod, static_cast<size_t>(HttpVerb::Max)> perMethods;
+    // Every verb's rules, indexed together
+    RouteTable routes;
 
-    PerMethod notFoundRoutes;
-    PerMethod upgradeRoutes;
-    PerMethod methodNotAllowedRoutes;
+    RouteTable notFoundRoutes;
+    RouteTable upgradeRoutes;
+    RouteTable methodNotAllowedRoutes;
 
     std::vector<std::unique_ptr<BaseRule>> allRules;
 };
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <sys/sendfile.h>
+#include <sys/types.h>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace bmcweb
+{
+
+// Linux transfers at most this many bytes in a single sendfile(2) call
+constexpr size_t maxSendFileChunk = 0x7ffff000;
+
+template <typename Socket, typename Handler>
+struct SendFileOp
+{
+    Socket& socket;
+    int fd;
+    off_t offset;
+    size_t remaining;
+    size_t sent;
+    Handler handler;
+
+    // Each step runs wherever the handler expects to be completed
+    using executor_type =
+        boost::asio::associated_executor_t<Handler,
+                                           typename Socket::executor_type>;
+
+    executor_type get_executor() const noexcept
+    {
+        return boost::asio::get_associated_executor(handler,
+                                                    socket.get_executor());
+    }
+
+    void operator()(const boost::system::error_code& ec)
+    {
+        if (ec || remaining == 0)
+        {
+            handler(ec, sent);
+            return;
+        }
+        ssize_t ret = ::sendfile(socket.native_handle(), fd, &offset,
+                                 std::min(remaining, maxSendFileChunk));
+        if (ret < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                handler(boost::system::error_code(
+                            errno, boost::system::system_category()),
+                        sent);
+                return;
+            }
+        }
+        else if (ret == 0)
+        {
+            // The file was truncated while we were sending it
+            BMCWEB_LOG_ERROR("File ended with {} bytes left to send",
+                             remaining);
+            handler(boost::asio::error::eof, sent);
+            return;
+        }
+        else
+        {
+            sent += static_cast<size_t>(ret);
+            remaining -= static_cast<size_t>(ret);
+        }
+        if (remaining == 0)
+        {
+            handler(boost::system::error_code(), sent);
+            return;
+        }
+        // Waiting for writability between calls, rather than looping, bounds
+        // each pass to what the socket buffer can take, and lets other
+        // connections run in between.
+        socket.async_wait(boost::asio::socket_base::wait_write,
+                          std::move(*this));
+    }
+};
+
+// Sends length bytes of the file fd, starting at offset, to socket using
+// sendfile(2).  Data moves from the page cache to the socket within the kernel
+// instead of being copied through a userspace buffer.  Completes with the
+// number of bytes sent.  sendfile fails with EINVAL or ENOSYS before sending
+// anything for files that don't support it, so callers can fall back to
+// reading the file themselves.
+template <typename Socket, typename Handler>
+void asyncSendFile(Socket& socket, int fd, off_t offset, size_t length,
+                   Handler&& handler)
+{
+    boost::system::error_code ec;
+    socket.native_non_blocking(true, ec);
+    if (ec)
+    {
+        handler(ec, 0U);
+        return;
+    }
+    socket.async_wait(boost::asio::socket_base::wait_write,
+                      SendFileOp<Socket, std::decay_t<Handler>>{
+                          socket, fd, offset, length, 0U,
+                          std::forward<Handler>(handler)});
+}
+
+} // namespace bmcweb
@@ -6,6 +6,7 @@
 #include "http_response.hpp"
 #include "logging.hpp"
 #include "routing/baserule.hpp"
+#include "user_info_cache.hpp"
 #include "utils/dbus_utils.hpp"
 
 #include <boost/url/format.hpp>
@@ -147,6 +148,30 @@ void requestUserInfo(const std::string& username,
         "xyz.openbmc_project.User.Manager", "GetUserInfo", username);
 }
 
+// Like requestUserInfo, but answers from the cache when it can
+template <typename CallbackFn>
+void requestCachedUserInfo(const std::string& username,
+                           const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           CallbackFn&& callback)
+{
+    bmcweb::UserInfoCache& cache = bmcweb::UserInfoCache::getInstance();
+    bmcweb::UserInfoCache::UserInfo userInfo = cache.lookup(username);
+    if (userInfo != nullptr)
+    {
+        callback(*userInfo);
+        return;
+    }
+    requestUserInfo(username, asyncResp,
+                    [username, generation = cache.generation(),
+                     callback = std::forward<CallbackFn>(callback)](
+                        const dbus::utility::DBusPropertiesMap&
+                            userInfoMap) mutable {
+        bmcweb::UserInfoCache::getInstance().insert(username, userInfoMap,
+                                                    generation);
+        callback(userInfoMap);
+    });
+}
+
 template <typename CallbackFn>
 void validatePrivilege(const std::shared_ptr<Request>& req,
                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -157,7 +182,7 @@ void validatePrivilege(const std::shared_ptr<Request>& req,
         return;
     }
 
-    requestUserInfo(
+    requestCachedUserInfo(
         req->session->username, asyncResp,
         [req, asyncResp, &rule, callback = std::forward<CallbackFn>(callback)](
             const dbus::utility::DBusPropertiesMap& userInfoMap) mutable {
@@ -174,10 +199,16 @@ void getUserInfo(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                  std::shared_ptr<persistent_data::UserSession>& session,
                  CallbackFn&& callback)
 {
+    // Logging in always fetches the user's current information, which then
+    // serves the requests that follow
     requestUserInfo(
         username, asyncResp,
-        [asyncResp, session, callback = std::forward<CallbackFn>(callback)](
+        [asyncResp, session, username,
+         generation = bmcweb::UserInfoCache::getInstance().generation(),
+         callback = std::forward<CallbackFn>(callback)](
             const dbus::utility::DBusPropertiesMap& userInfoMap) {
+        bmcweb::UserInfoCache::getInstance().insert(username, userInfoMap,
+                                                    generation);
         if (!populateUserInfo(*session, userInfoMap))
         {
             BMCWEB_LOG_ERROR("Failed to populate user information");
@@ -15,19 +15,27 @@
  */
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "boost_formatters.hpp"
 #include "dbus_singleton.hpp"
 #include "logging.hpp"
+#include "mapper_cache.hpp"
+#include "single_flight.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/system/error_code.hpp> // IWYU pragma: keep
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <regex>
 #include <span>
 #include <sstream>
@@ -159,20 +167,187 @@ inline void checkDbusPathExists(const std::string& path, Callback&& callback)
         std::array<std::string, 0>());
 }
 
+template <typename Response>
+inline SingleFlight<Response>& getSingleFlight()
+{
+    static SingleFlight<Response> flights;
+    return flights;
+}
+
+// Makes the D-Bus call that startCall starts, unless a call identified by the
+// same key is already in flight, in which case its reply is shared.  The key
+// needs to capture everything that the reply depends on.
+template <typename Response, typename StartCall>
+inline void callSingleFlight(
+    const std::string& key,
+    std::function<void(const boost::system::error_code&, const Response&)>&&
+        callback,
+    StartCall&& startCall)
+{
+    std::shared_ptr<typename SingleFlight<Response>::Flight> flight =
+        getSingleFlight<Response>().join(key, std::move(callback));
+    if (flight == nullptr)
+    {
+        return;
+    }
+    startCall([key, flight{std::move(flight)}](
+                  const boost::system::error_code& ec,
+                  const Response& response) {
+        getSingleFlight<Response>().complete(key, flight, ec, response);
+    });
+}
+
+template <typename Response>
+inline MapperCache<Response>& getMapperCache()
+{
+    static MapperCache<Response> cache{
+        std::chrono::seconds(BMCWEB_MAPPER_CACHE_TTL)};
+    return cache;
+}
+
+// Identifies a mapper query by its method and arguments
+inline std::string
+    makeMapperCacheKey(std::string_view method,
+                       std::span<const std::string_view> paths, int32_t depth,
+                       std::span<const std::string_view> interfaces)
+{
+    std::string key(method);
+    for (std::string_view path : paths)
+    {
+        key += ' ';
+        key += path;
+    }
+    key += ' ';
+    key += std::to_string(depth);
+    for (std::string_view interface : interfaces)
+    {
+        key += ' ';
+        key += interface;
+    }
+    return key;
+}
+
+// Makes a call to the ObjectMapper, unless the same query was answered
+// recently, or is already in flight
+template <typename Response, typename... Args>
+inline void callMapperCached(
+    const std::string& key,
+    std::function<void(const boost::system::error_code&, const Response&)>&&
+        callback,
+    const char* method, const Args&... args)
+{
+    MapperCache<Response>& cache = getMapperCache<Response>();
+    if (!cache.enabled())
+    {
+        callSingleFlight<Response>(key, std::move(callback),
+                                   [method, &args...](auto&& done) {
+            crow::connections::systemBus->async_method_call(
+                std::forward<decltype(done)>(done),
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", method, args...);
+        });
+        return;
+    }
+
+    std::shared_ptr<const Response> cached =
+        cache.find(key, MapperCache<Response>::Clock::now());
+    if (cached != nullptr)
+    {
+        // Callers expect to be called back asynchronously, as they would be
+        // by D-Bus
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [callback{std::move(callback)},
+                           cached{std::move(cached)}]() {
+            callback(boost::system::error_code(), *cached);
+        });
+        return;
+    }
+
+    std::shared_ptr<typename MapperCache<Response>::Flight> flight =
+        cache.join(key, std::move(callback));
+    if (flight == nullptr)
+    {
+        return;
+    }
+    crow::connections::systemBus->async_method_call(
+        [key, flight{std::move(flight)}](const boost::system::error_code& ec,
+                                         const Response& response) {
+        getMapperCache<Response>().complete(
+            key, flight, ec, response, MapperCache<Response>::Clock::now());
+    },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", method, args...);
+}
+
+inline void invalidateMapperCache()
+{
+    getMapperCache<MapperGetSubTreeResponse>().invalidate();
+    getMapperCache<MapperGetSubTreePathsResponse>().invalidate();
+}
+
+inline void onMapperNameOwnerChanged(sdbusplus::message_t& msg)
+{
+    std::string name;
+    std::string oldOwner;
+    std::string newOwner;
+    msg.read(name, oldOwner, newOwner);
+    // Unique names come and go with every client, and never own objects the
+    // mapper knows about
+    if (name.starts_with(':'))
+    {
+        return;
+    }
+    invalidateMapperCache();
+}
+
+// Drops cached mapper replies whenever objects, or the services that provide
+// them, come or go, or an association changes.  A new service is only known
+// to the mapper once it has introspected it, some time after NameOwnerChanged,
+// so replies cached in between are dropped again on IntrospectionComplete.
+inline void registerMapperCacheInvalidation()
+{
+    if constexpr (BMCWEB_MAPPER_CACHE_TTL == 0)
+    {
+        return;
+    }
+    auto invalidate = [](sdbusplus::message_t& /*msg*/) {
+        invalidateMapperCache();
+    };
+    static sdbusplus::bus::match_t interfacesAddedMatch(
+        *crow::connections::systemBus,
+        sdbusplus::bus::match::rules::interfacesAdded(), invalidate);
+    static sdbusplus::bus::match_t interfacesRemovedMatch(
+        *crow::connections::systemBus,
+        sdbusplus::bus::match::rules::interfacesRemoved(), invalidate);
+    static sdbusplus::bus::match_t associationsChangedMatch(
+        *crow::connections::systemBus,
+        "type='signal',member='PropertiesChanged',"
+        "interface='org.freedesktop.DBus.Properties',"
+        "arg0='xyz.openbmc_project.Association'",
+        invalidate);
+    static sdbusplus::bus::match_t nameOwnerChangedMatch(
+        *crow::connections::systemBus,
+        sdbusplus::bus::match::rules::nameOwnerChanged(),
+        onMapperNameOwnerChanged);
+    static sdbusplus::bus::match_t introspectionCompleteMatch(
+        *crow::connections::systemBus,
+        "type='signal',member='IntrospectionComplete',"
+        "interface='xyz.openbmc_project.ObjectMapper.Private'",
+        invalidate);
+}
+
 inline void
     getSubTree(const std::string& path, int32_t depth,
                std::span<const std::string_view> interfaces,
                std::function<void(const boost::system::error_code&,
                                   const MapperGetSubTreeResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreeResponse& subtree) { callback(ec, subtree); },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree", path, depth,
-        interfaces);
+    std::array<std::string_view, 1> paths{path};
+    callMapperCached<MapperGetSubTreeResponse>(
+        makeMapperCacheKey("GetSubTree", paths, depth, interfaces),
+        std::move(callback), "GetSubTree", path, depth, interfaces);
 }
 
 inline void getSubTreePaths(
@@ -181,16 +356,10 @@ inline void getSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreePathsResponse& subtreePaths) {
-        callback(ec, subtreePaths);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", path, depth,
-        interfaces);
+    std::array<std::string_view, 1> paths{path};
+    callMapperCached<MapperGetSubTreePathsResponse>(
+        makeMapperCacheKey("GetSubTreePaths", paths, depth, interfaces),
+        std::move(callback), "GetSubTreePaths", path, depth, interfaces);
 }
 
 inline void getAssociatedSubTree(
@@ -200,14 +369,11 @@ inline void getAssociatedSubTree(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreeResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreeResponse& subtree) { callback(ec, subtree); },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetAssociatedSubTree",
-        associatedPath, path, depth, interfaces);
+    std::array<std::string_view, 2> paths{associatedPath.str, path.str};
+    callMapperCached<MapperGetSubTreeResponse>(
+        makeMapperCacheKey("GetAssociatedSubTree", paths, depth, interfaces),
+        std::move(callback), "GetAssociatedSubTree", associatedPath, path,
+        depth, interfaces);
 }
 
 inline void getAssociatedSubTreePaths(
@@ -217,16 +383,12 @@ inline void getAssociatedSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreePathsResponse& subtreePaths) {
-        callback(ec, subtreePaths);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetAssociatedSubTreePaths",
-        associatedPath, path, depth, interfaces);
+    std::array<std::string_view, 2> paths{associatedPath.str, path.str};
+    callMapperCached<MapperGetSubTreePathsResponse>(
+        makeMapperCacheKey("GetAssociatedSubTreePaths", paths, depth,
+                           interfaces),
+        std::move(callback), "GetAssociatedSubTreePaths", associatedPath,
+        path, depth, interfaces);
 }
 
 inline void
@@ -235,14 +397,17 @@ inline void
                   std::function<void(const boost::system::error_code&,
                                      const MapperGetObject&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const MapperGetObject& object) {
-        callback(ec, object);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject", path, interfaces);
+    std::array<std::string_view, 1> paths{path};
+    callSingleFlight<MapperGetObject>(
+        makeMapperCacheKey("GetObject", paths, 0, interfaces),
+        std::move(callback), [&path, interfaces](auto&& done) {
+        crow::connections::systemBus->async_method_call(
+            std::forward<decltype(done)>(done),
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetObject", path,
+            interfaces);
+    });
 }
 
 inline void getAssociationEndPoints(
@@ -250,9 +415,13 @@ inline void getAssociationEndPoints(
     std::function<void(const boost::system::error_code&,
                        const MapperEndPoints&)>&& callback)
 {
-    sdbusplus::asio::getProperty<MapperEndPoints>(
-        *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper", path,
-        "xyz.openbmc_project.Association", "endpoints", std::move(callback));
+    callSingleFlight<MapperEndPoints>(
+        "endpoints " + path, std::move(callback), [&path](auto&& done) {
+        sdbusplus::asio::getProperty<MapperEndPoints>(
+            *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper",
+            path, "xyz.openbmc_project.Association", "endpoints",
+            std::forward<decltype(done)>(done));
+    });
 }
 
 inline void
@@ -261,13 +430,13 @@ inline void
                       std::function<void(const boost::system::error_code&,
                                          const ManagedObjectType&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const ManagedObjectType& objects) {
-        callback(ec, objects);
-    },
-        service, path, "org.freedesktop.DBus.ObjectManager",
-        "GetManagedObjects");
+    callSingleFlight<ManagedObjectType>(
+        "GetManagedObjects " + service + " " + path.str, std::move(callback),
+        [&service, &path](auto&& done) {
+        crow::connections::systemBus->async_method_call(
+            std::forward<decltype(done)>(done), service, path,
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 } // namespace utility
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "str_utility.hpp"
+
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
@@ -59,8 +61,8 @@ inline ContentType
             header.remove_prefix(1);
         }
         lastIndex = index + 1;
-        // ignore any q-factor weighting (;q=)
-        std::size_t separator = encoding.find(";q=");
+        // ignore any media type parameters, including q-factor weighting (;q=)
+        std::size_t separator = encoding.find(';');
 
         if (separator != std::string_view::npos)
         {
@@ -95,6 +97,50 @@ inline ContentType
     return ContentType::NoMatch;
 }
 
+enum class JsonFormat
+{
+    Default,
+    Pretty,
+    Compact,
+};
+
+// Returns the json formatting requested through a "format" parameter on the
+// application/json media range of an Accept header, for example
+// "Accept: application/json;format=compact"
+inline JsonFormat getJsonFormat(std::string_view header)
+{
+    while (!header.empty())
+    {
+        size_t comma = header.find(',');
+        std::string_view mediaRange = header.substr(0, comma);
+        header.remove_prefix(
+            comma == std::string_view::npos ? header.size() : comma + 1);
+
+        size_t semicolon = mediaRange.find(';');
+        if (bmcweb::trimSpaces(mediaRange.substr(0, semicolon)) !=
+            "application/json")
+        {
+            continue;
+        }
+        while (semicolon != std::string_view::npos)
+        {
+            mediaRange.remove_prefix(semicolon + 1);
+            semicolon = mediaRange.find(';');
+            std::string_view param =
+                bmcweb::trimSpaces(mediaRange.substr(0, semicolon));
+            if (param == "format=compact")
+            {
+                return JsonFormat::Compact;
+            }
+            if (param == "format=pretty")
+            {
+                return JsonFormat::Pretty;
+            }
+        }
+    }
+    return JsonFormat::Default;
+}
+
 inline bool isContentTypeAllowed(std::string_view header, ContentType type,
                                  bool allowWildcard)
 {
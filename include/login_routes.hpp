@@ -6,7 +6,9 @@
 #include "multipart_parser.hpp"
 #include "pam_authenticate.hpp"
 #include "webassets.hpp"
+#include "worker_pool.hpp"
 
+#include <boost/asio/ip/address.hpp>
 #include <boost/container/flat_set.hpp>
 
 #include <random>
@@ -17,6 +19,34 @@ namespace crow
 namespace login_routes
 {
 
+inline void
+    afterLoginAuthenticate(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::string& username,
+                           const boost::asio::ip::address& ipAddress,
+                           int pamrc)
+{
+    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
+    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    {
+        asyncResp->res.result(boost::beast::http::status::unauthorized);
+        return;
+    }
+    auto session =
+        persistent_data::SessionStore::getInstance().generateUserSession(
+            username, ipAddress, std::nullopt,
+            persistent_data::PersistenceType::TIMEOUT, isConfigureSelfOnly);
+
+    asyncResp->res.addHeader(boost::beast::http::field::set_cookie,
+                             "XSRF-TOKEN=" + session->csrfToken +
+                                 "; SameSite=Strict; Secure");
+    asyncResp->res.addHeader(boost::beast::http::field::set_cookie,
+                             "SESSION=" + session->sessionToken +
+                                 "; SameSite=Strict; Secure; HttpOnly");
+
+    // if content type is json, assume json token
+    asyncResp->res.jsonValue["token"] = session->sessionToken;
+}
+
 inline void handleLogin(const crow::Request& req,
                         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
@@ -152,29 +182,23 @@ inline void handleLogin(const crow::Request& req,
 
     if (!username.empty() && !password.empty())
     {
-        int pamrc = pamAuthenticateUser(username, password);
-        bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
-        if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
-        {
-            asyncResp->res.result(boost::beast::http::status::unauthorized);
-        }
-        else
+        bool queued = bmcweb::WorkerPool::getInstance().post(
+            "PamAuthenticate",
+            [username = std::string(username),
+             password = std::string(password)]() {
+            return pamAuthenticateUser(username, password);
+        },
+            [asyncResp, username = std::string(username),
+             ipAddress = req.ipAddress](int pamrc) {
+            afterLoginAuthenticate(asyncResp, username, ipAddress, pamrc);
+        });
+        if (!queued)
         {
-            auto session = persistent_data::SessionStore::getInstance()
-                               .generateUserSession(
-                                   username, req.ipAddress, std::nullopt,
-                                   persistent_data::PersistenceType::TIMEOUT,
-                                   isConfigureSelfOnly);
-
-            asyncResp->res.addHeader(boost::beast::http::field::set_cookie,
-                                     "XSRF-TOKEN=" + session->csrfToken +
-                                         "; SameSite=Strict; Secure");
-            asyncResp->res.addHeader(boost::beast::http::field::set_cookie,
-                                     "SESSION=" + session->sessionToken +
-                                         "; SameSite=Strict; Secure; HttpOnly");
-
-            // if content type is json, assume json token
-            asyncResp->res.jsonValue["token"] = session->sessionToken;
+            asyncResp->res.result(
+                boost::beast::http::status::service_unavailable);
+            asyncResp->res.addHeader(
+                boost::beast::http::field::retry_after,
+                std::to_string(bmcweb::WorkerPool::retryAfter.count()));
         }
     }
     else
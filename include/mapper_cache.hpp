@@ -0,0 +1,142 @@
+#pragma once
+
+#include "logging.hpp"
+#include "single_flight.hpp"
+
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace dbus
+{
+namespace utility
+{
+
+struct MapperCacheStats
+{
+    size_t hits = 0;
+    size_t invalidations = 0;
+};
+
+// Remembers the replies of ObjectMapper queries, keyed on the method and its
+// arguments.  Identical queries made while one is already in flight wait for
+// its reply rather than making their own call.  Everything is dropped when
+// the set of objects on the bus changes, and in any case once older than the
+// configured ttl.  Only used from the main io_context.
+template <typename Response>
+class MapperCache
+{
+  public:
+    using Callback = typename SingleFlight<Response>::Callback;
+    using Flight = typename SingleFlight<Response>::Flight;
+    using Clock = std::chrono::steady_clock;
+
+    // Subtrees of a large sensor tree run to hundreds of kilobytes, so only
+    // the most recent queries are kept
+    static constexpr size_t maxEntries = 128;
+
+    explicit MapperCache(std::chrono::seconds ttlIn) : ttl(ttlIn) {}
+
+    bool enabled() const
+    {
+        return ttl.count() != 0;
+    }
+
+    std::shared_ptr<const Response> find(const std::string& key,
+                                         Clock::time_point now)
+    {
+        auto it = entries.find(key);
+        if (it == entries.end())
+        {
+            return nullptr;
+        }
+        if (now - it->second.fetched >= ttl)
+        {
+            entries.erase(it);
+            return nullptr;
+        }
+        stats.hits++;
+        return it->second.response;
+    }
+
+    // Queues callback for the reply to the query key.  Returns the Flight
+    // the caller needs to make the call for, and pass to complete(), or
+    // nullptr if the same query is already in flight.
+    std::shared_ptr<Flight> join(const std::string& key, Callback&& callback)
+    {
+        return flights.join(key, std::move(callback));
+    }
+
+    void complete(const std::string& key,
+                  const std::shared_ptr<Flight>& flight,
+                  const boost::system::error_code& ec,
+                  const Response& response, Clock::time_point now)
+    {
+        // A flight started before an invalidation was already forgotten,
+        // and its reply may be stale, so it's handed out but not stored
+        if (flights.finish(key, flight) && !ec)
+        {
+            store(key, response, now);
+        }
+        SingleFlight<Response>::deliver(flight, ec, response);
+    }
+
+    void invalidate()
+    {
+        entries.clear();
+        flights.clear();
+        stats.invalidations++;
+        BMCWEB_LOG_DEBUG("Mapper cache invalidated");
+    }
+
+    const MapperCacheStats& getStats() const
+    {
+        return stats;
+    }
+
+    const SingleFlightStats& getFlightStats() const
+    {
+        return flights.getStats();
+    }
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<const Response> response;
+        Clock::time_point fetched;
+    };
+
+    void store(const std::string& key, const Response& response,
+               Clock::time_point now)
+    {
+        if (entries.size() >= maxEntries && !entries.contains(key))
+        {
+            // Evict the oldest entry
+            auto oldest = entries.begin();
+            for (auto it = entries.begin(); it != entries.end(); it++)
+            {
+                if (it->second.fetched < oldest->second.fetched)
+                {
+                    oldest = it;
+                }
+            }
+            entries.erase(oldest);
+        }
+        entries.insert_or_assign(
+            key, Entry{std::make_shared<const Response>(response), now});
+    }
+
+    std::chrono::seconds ttl;
+    std::map<std::string, Entry, std::less<>> entries;
+    SingleFlight<Response> flights;
+    MapperCacheStats stats;
+};
+
+} // namespace utility
+} // namespace dbus
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dbus
+{
+namespace utility
+{
+
+struct SingleFlightStats
+{
+    // Calls actually made
+    size_t calls = 0;
+    // Calls saved, by sharing the reply of an identical call in flight
+    size_t coalesced = 0;
+};
+
+// Shares one D-Bus call between everyone making the same call at the same
+// time.  The first caller makes the call, identical calls made before its
+// reply arrives are queued, and the reply is handed to all of them.  Only
+// used from the main io_context.
+template <typename Response>
+class SingleFlight
+{
+  public:
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const Response&)>;
+
+    // A call in flight, and everyone waiting for its reply
+    struct Flight
+    {
+        std::vector<Callback> waiters;
+    };
+
+    // Queues callback for the reply to the call identified by key.  Returns
+    // the Flight the caller needs to make the call for, and pass to
+    // complete(), or nullptr if the same call is already in flight.
+    std::shared_ptr<Flight> join(const std::string& key, Callback&& callback)
+    {
+        auto it = flights.find(key);
+        if (it != flights.end())
+        {
+            stats.coalesced++;
+            BMCWEB_LOG_DEBUG("Joined call in flight for {}, {} calls saved",
+                             key, stats.coalesced);
+            it->second->waiters.emplace_back(std::move(callback));
+            return nullptr;
+        }
+        stats.calls++;
+        auto flight = std::make_shared<Flight>();
+        flight->waiters.emplace_back(std::move(callback));
+        flights.emplace(key, flight);
+        return flight;
+    }
+
+    // Stops new callers from joining flight.  Returns false if it was
+    // already forgotten by clear().
+    bool finish(const std::string& key, const std::shared_ptr<Flight>& flight)
+    {
+        auto it = flights.find(key);
+        if (it == flights.end() || it->second != flight)
+        {
+            return false;
+        }
+        flights.erase(it);
+        return true;
+    }
+
+    static void deliver(const std::shared_ptr<Flight>& flight,
+                        const boost::system::error_code& ec,
+                        const Response& response)
+    {
+        // Callbacks may make new calls, so are run off a local copy
+        std::vector<Callback> waiters = std::move(flight->waiters);
+        for (Callback& waiter : waiters)
+        {
+            waiter(ec, response);
+        }
+    }
+
+    void complete(const std::string& key,
+                  const std::shared_ptr<Flight>& flight,
+                  const boost::system::error_code& ec,
+                  const Response& response)
+    {
+        finish(key, flight);
+        deliver(flight, ec, response);
+    }
+
+    // Makes later callers start a new call, rather than wait for the ones
+    // already in flight, whose replies may be out of date
+    void clear()
+    {
+        flights.clear();
+    }
+
+    const SingleFlightStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    std::map<std::string, std::shared_ptr<Flight>, std::less<>> flights;
+    SingleFlightStats stats;
+};
+
+} // namespace utility
+} // namespace dbus
@@ -41,4 +41,16 @@ inline bool asciiIEquals(std::string_view left, std::string_view right)
     });
 }
 
+// Strips the spaces and tabs that may surround a token in an HTTP header
+inline std::string_view trimSpaces(std::string_view str)
+{
+    size_t first = str.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    size_t last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
 } // namespace bmcweb
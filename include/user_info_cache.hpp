@@ -0,0 +1,168 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace bmcweb
+{
+
+struct UserInfoCacheStats
+{
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t invalidations = 0;
+};
+
+// Remembers the result of GetUserInfo for each user, so that authorizing a
+// request doesn't need a D-Bus round trip to the user manager.  Entries are
+// dropped whenever the user manager signals a change, and in any case once
+// they're older than the configured ttl.  Only used from the main io_context.
+class UserInfoCache
+{
+  public:
+    using UserInfo = std::shared_ptr<const dbus::utility::DBusPropertiesMap>;
+    using Clock = std::chrono::steady_clock;
+
+    // More distinct users than this at once is unusual, even with LDAP
+    static constexpr size_t maxEntries = 64;
+    // The hit and miss counts are logged every so many lookups
+    static constexpr size_t summaryInterval = 1000;
+
+    explicit UserInfoCache(std::chrono::seconds ttlIn) : ttl(ttlIn) {}
+
+    static UserInfoCache& getInstance()
+    {
+        static UserInfoCache cache{
+            std::chrono::seconds(BMCWEB_USER_INFO_CACHE_TTL)};
+        return cache;
+    }
+
+    UserInfo lookup(std::string_view username, Clock::time_point now)
+    {
+        UserInfo userInfo;
+        auto it = entries.find(username);
+        if (it != entries.end() && now - it->second.fetched < ttl)
+        {
+            stats.hits++;
+            userInfo = it->second.userInfo;
+        }
+        else
+        {
+            stats.misses++;
+        }
+        if ((stats.hits + stats.misses) % summaryInterval == 0)
+        {
+            BMCWEB_LOG_INFO(
+                "User info cache: {} hits, {} misses, {} invalidations",
+                stats.hits, stats.misses, stats.invalidations);
+        }
+        return userInfo;
+    }
+
+    UserInfo lookup(std::string_view username)
+    {
+        return lookup(username, Clock::now());
+    }
+
+    // Changes whenever the cache is invalidated.  Results of lookups that
+    // started before an invalidation may already be stale, and aren't stored.
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    void insert(const std::string& username,
+                const dbus::utility::DBusPropertiesMap& userInfo,
+                uint64_t lookupGeneration, Clock::time_point fetched)
+    {
+        if (ttl.count() == 0 || lookupGeneration != currentGeneration)
+        {
+            return;
+        }
+        if (passwordExpired(userInfo))
+        {
+            // Changing the password isn't signalled, and the user has to
+            // change it before doing anything else
+            return;
+        }
+        if (entries.size() >= maxEntries && !entries.contains(username))
+        {
+            // Evict the oldest entry
+            auto oldest = entries.begin();
+            for (auto it = entries.begin(); it != entries.end(); it++)
+            {
+                if (it->second.fetched < oldest->second.fetched)
+                {
+                    oldest = it;
+                }
+            }
+            entries.erase(oldest);
+        }
+        entries.insert_or_assign(
+            username,
+            Entry{std::make_shared<const dbus::utility::DBusPropertiesMap>(
+                      userInfo),
+                  fetched});
+    }
+
+    void insert(const std::string& username,
+                const dbus::utility::DBusPropertiesMap& userInfo,
+                uint64_t lookupGeneration)
+    {
+        insert(username, userInfo, lookupGeneration, Clock::now());
+    }
+
+    void invalidate()
+    {
+        entries.clear();
+        currentGeneration++;
+        stats.invalidations++;
+        BMCWEB_LOG_DEBUG("User info cache invalidated");
+    }
+
+    const UserInfoCacheStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    static bool passwordExpired(
+        const dbus::utility::DBusPropertiesMap& userInfo)
+    {
+        auto it = std::ranges::find_if(userInfo, [](const auto& property) {
+            return property.first == "UserPasswordExpired";
+        });
+        if (it == userInfo.end())
+        {
+            return false;
+        }
+        const bool* expired = std::get_if<bool>(&it->second);
+        return expired != nullptr && *expired;
+    }
+
+    struct Entry
+    {
+        UserInfo userInfo;
+        Clock::time_point fetched;
+    };
+
+    std::chrono::seconds ttl;
+    std::map<std::string, Entry, std::less<>> entries;
+    uint64_t currentGeneration = 0;
+    UserInfoCacheStats stats;
+};
+
+} // namespace bmcweb
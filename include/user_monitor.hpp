@@ -2,6 +2,7 @@
 #include "dbus_singleton.hpp"
 #include "dbus_utility.hpp"
 #include "persistent_data.hpp"
+#include "user_info_cache.hpp"
 
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message/types.hpp>
@@ -16,6 +17,14 @@ inline void onUserRemoved(sdbusplus::message_t& msg)
     std::string username = p.filename();
     persistent_data::SessionStore::getInstance().removeSessionsByUsername(
         username);
+    UserInfoCache::getInstance().invalidate();
+}
+
+inline void onUserChanged(sdbusplus::message_t& /*msg*/)
+{
+    // Group membership, privilege and enabled state all feed into the
+    // privileges of a user, so any change drops what's cached
+    UserInfoCache::getInstance().invalidate();
 }
 
 inline void registerUserRemovedSignal()
@@ -27,4 +36,20 @@ inline void registerUserRemovedSignal()
     static sdbusplus::bus::match_t userRemovedMatch(
         *crow::connections::systemBus, userRemovedMatchStr, onUserRemoved);
 }
+
+inline void registerUserChangedSignal()
+{
+    std::string userChangedMatchStr =
+        "type='signal',member='PropertiesChanged',"
+        "interface='org.freedesktop.DBus.Properties',"
+        "path_namespace='/xyz/openbmc_project/user'";
+    std::string userAddedMatchStr =
+        sdbusplus::bus::match::rules::interfacesAdded(
+            "/xyz/openbmc_project/user");
+
+    static sdbusplus::bus::match_t userChangedMatch(
+        *crow::connections::systemBus, userChangedMatchStr, onUserChanged);
+    static sdbusplus::bus::match_t userAddedMatch(
+        *crow::connections::systemBus, userAddedMatchStr, onUserChanged);
+}
 } // namespace bmcweb
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace bmcweb
+{
+
+struct WorkerTaskStats
+{
+    size_t count = 0;
+    // Tasks that were run on the calling thread because no workers were
+    // configured
+    size_t ranInline = 0;
+    // Tasks turned away because the queue was full
+    size_t rejected = 0;
+    std::chrono::steady_clock::duration totalWait{};
+    std::chrono::steady_clock::duration maxWait{};
+    std::chrono::steady_clock::duration totalRun{};
+    std::chrono::steady_clock::duration maxRun{};
+};
+
+// Runs CPU heavy parts of request handling on a small, fixed set of threads so
+// that they don't stall every other connection on the main io_context.  Work
+// must only use its own captured state, and never a Request or AsyncResp,
+// which may belong to a connection's arena;  the result is moved back to the
+// main io_context, where the completion may touch application state as usual.
+class WorkerPool
+{
+  public:
+    // Once this many tasks per thread are waiting, new work is turned away,
+    // rather than being run on the thread the pool exists to keep free
+    static constexpr size_t maxPendingPerThread = 8;
+    // How long clients whose work was turned away are asked to wait
+    static constexpr std::chrono::seconds retryAfter{1};
+
+    WorkerPool(boost::asio::io_context& ioIn, size_t threadsIn) :
+        io(ioIn), threads(threadsIn)
+    {
+        if (threads > 0)
+        {
+            pool.emplace(threads);
+            BMCWEB_LOG_INFO("Running request work on {} worker threads",
+                            threads);
+        }
+    }
+
+    ~WorkerPool()
+    {
+        stop();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    static WorkerPool& getInstance(boost::asio::io_context* ioIn = nullptr)
+    {
+        static WorkerPool handler(*ioIn,
+                                  static_cast<size_t>(BMCWEB_WORKER_THREADS));
+        return handler;
+    }
+
+    // Runs work on a worker thread, then calls completion with its result on
+    // the io_context.  Must be called from the io_context thread.  Returns
+    // false, having run neither, when the queue is full;  the caller should
+    // then reply 503, asking the client to retry after retryAfter.
+    template <typename Work, typename Completion>
+    [[nodiscard]] bool post(std::string_view name, Work&& work,
+                            Completion&& completion)
+    {
+        using Result = std::invoke_result_t<std::decay_t<Work>&>;
+        using Clock = std::chrono::steady_clock;
+
+        if (!pool)
+        {
+            Clock::time_point start = Clock::now();
+            Result result = std::invoke(work);
+            record(name, true, {}, Clock::now() - start);
+            std::invoke(completion, std::move(result));
+            return true;
+        }
+        if (pending.load() >= threads * maxPendingPerThread)
+        {
+            BMCWEB_LOG_WARNING("Worker queue full, turning away {}", name);
+            taskStats[std::string(name)].rejected++;
+            return false;
+        }
+
+        pending++;
+        Clock::time_point queued = Clock::now();
+        boost::asio::post(
+            *pool, [this, taskName = std::string(name), queued,
+                    work = std::forward<Work>(work),
+                    completion = std::forward<Completion>(completion)]() mutable {
+            Clock::time_point start = Clock::now();
+            Result result = std::invoke(work);
+            Clock::duration run = Clock::now() - start;
+            pending--;
+            boost::asio::post(io, [this, taskName = std::move(taskName),
+                                   wait = start - queued, run,
+                                   completion = std::move(completion),
+                                   result = std::move(result)]() mutable {
+                record(taskName, false, wait, run);
+                std::invoke(completion, std::move(result));
+            });
+        });
+        return true;
+    }
+
+    // Waits for queued work to finish and stops the threads.  Completions
+    // that haven't run yet stay queued on the io_context.
+    void stop()
+    {
+        if (pool)
+        {
+            pool->join();
+            pool.reset();
+        }
+    }
+
+    const std::map<std::string, WorkerTaskStats, std::less<>>& stats() const
+    {
+        return taskStats;
+    }
+
+  private:
+    void record(std::string_view name, bool ranInline,
+                std::chrono::steady_clock::duration wait,
+                std::chrono::steady_clock::duration run)
+    {
+        auto it = taskStats.find(name);
+        if (it == taskStats.end())
+        {
+            it = taskStats.emplace(std::string(name), WorkerTaskStats{}).first;
+        }
+        WorkerTaskStats& task = it->second;
+        task.count++;
+        if (ranInline)
+        {
+            task.ranInline++;
+        }
+        task.totalWait += wait;
+        task.maxWait = std::max(task.maxWait, wait);
+        task.totalRun += run;
+        task.maxRun = std::max(task.maxRun, run);
+        BMCWEB_LOG_DEBUG(
+            "Task {} waited {}us and ran for {}us{}", name,
+            std::chrono::duration_cast<std::chrono::microseconds>(wait).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(run).count(),
+            ranInline ? " inline" : "");
+    }
+
+    boost::asio::io_context& io;
+    size_t threads;
+    std::atomic<size_t> pending = 0;
+    std::optional<boost::asio::thread_pool> pool;
+    // Only accessed from the io_context thread
+    std::map<std::string, WorkerTaskStats, std::less<>> taskStats;
+};
+
+} // namespace bmcweb
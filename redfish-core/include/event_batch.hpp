@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief Event records waiting to be sent to push style subscribers.
+ *
+ * Records that arrive close together are held here and sent as a single
+ * Event, with one Events array per subscriber.  Subscribers that were sent the
+ * same records share one serialized payload, so a burst of events is
+ * serialized once per distinct set of records rather than once per subscriber
+ * per event.  Only used from the main io_context.
+ */
+class EventBatch
+{
+  public:
+    // Called with the ID of a subscription, and the Event to send to it
+    using SendCallback = std::function<void(
+        const std::string& id, const std::shared_ptr<const std::string>& msg)>;
+
+    // Queues a record to be sent to each of the given subscriptions
+    void add(nlohmann::json&& record, const std::vector<std::string>& ids)
+    {
+        if (ids.empty())
+        {
+            return;
+        }
+        size_t index = records.size();
+        records.emplace_back(std::move(record));
+        for (const std::string& id : ids)
+        {
+            recipients[id].push_back(index);
+        }
+    }
+
+    bool empty() const
+    {
+        return records.empty();
+    }
+
+    size_t size() const
+    {
+        return records.size();
+    }
+
+    // Sends every queued record, and empties the batch.  Each distinct Event
+    // takes the next eventId.  Returns how many Events were serialized.
+    size_t flush(uint64_t& eventId, const SendCallback& send)
+    {
+        std::map<std::vector<size_t>, std::shared_ptr<const std::string>>
+            payloads;
+        for (const auto& [id, indexes] : recipients)
+        {
+            std::shared_ptr<const std::string>& payload = payloads[indexes];
+            if (payload == nullptr)
+            {
+                payload = std::make_shared<const std::string>(
+                    serialize(indexes, eventId++));
+            }
+            send(id, payload);
+        }
+        records.clear();
+        recipients.clear();
+        return payloads.size();
+    }
+
+  private:
+    std::string serialize(const std::vector<size_t>& indexes,
+                          uint64_t id) const
+    {
+        nlohmann::json::array_t events;
+        events.reserve(indexes.size());
+        for (size_t index : indexes)
+        {
+            nlohmann::json& event = events.emplace_back(records[index]);
+            event["MemberId"] = events.size() - 1;
+        }
+
+        nlohmann::json::object_t msg;
+        msg["@odata.type"] = "#Event.v1_4_0.Event";
+        msg["Name"] = "Event Log";
+        msg["Id"] = id;
+        msg["Events"] = std::move(events);
+        return nlohmann::json(std::move(msg))
+            .dump(BMCWEB_COMPACT_JSON ? -1 : 2, ' ', true,
+                  nlohmann::json::error_handler_t::replace);
+    }
+
+    std::vector<nlohmann::json> records;
+    // The records for each subscription, in the order they were added
+    std::map<std::string, std::vector<size_t>> recipients;
+};
+
+} // namespace redfish
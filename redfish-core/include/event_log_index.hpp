@@ -0,0 +1,407 @@
+#pragma once
+
+#include "logging.hpp"
+#include "registries.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ios>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+struct EventLogIndexStats
+{
+    size_t files = 0;
+    // Lines in every file, whether listed or not
+    size_t lines = 0;
+    // Bytes read to bring the index up to date, over its lifetime
+    uint64_t bytesRead = 0;
+    // Files read again from the start after being truncated
+    size_t reindexed = 0;
+};
+
+/**
+ * @brief Remembers where each entry of the Redfish event log files lives, so
+ * that a page of the collection, or a single entry, is read straight from its
+ * offset rather than by reading every rotated file from the start.
+ *
+ * Files are told apart by inode, so a file that's renamed as the logs rotate
+ * keeps its entries, and only the bytes appended to a file since it was last
+ * looked at are read.  The event log monitor calls changed() whenever the
+ * files change, and the next reader catches the index up.  Readers also stat
+ * the files, so changes the monitor misses are still picked up.  Entry IDs are
+ * made the same way the collection always has, restarting at each file.  Only
+ * used from the main io_context.
+ */
+class EventLogIndex
+{
+  public:
+    // Called with the ID and the text of each entry read, returns false to
+    // stop reading
+    using EntryCallback =
+        std::function<bool(const std::string& id, const std::string& line)>;
+
+    EventLogIndex(std::filesystem::path dirIn, std::string prefixIn) :
+        dir(std::move(dirIn)), prefix(std::move(prefixIn))
+    {}
+
+    static EventLogIndex& getInstance()
+    {
+        static EventLogIndex index("/var/log", "redfish");
+        return index;
+    }
+
+    void changed()
+    {
+        stale = true;
+    }
+
+    // Entries in the collection, that is the lines with a MessageId that's
+    // in a registry, or that can't be parsed at all
+    size_t size()
+    {
+        update();
+        return listedCount;
+    }
+
+    // Reads up to top collection entries, after skipping the first skip,
+    // oldest first.  Returns false if a file couldn't be read.
+    bool readEntries(size_t skip, size_t top, const EntryCallback& callback)
+    {
+        update();
+        for (const File& file : files)
+        {
+            if (top == 0)
+            {
+                break;
+            }
+            if (skip >= file.listed.size())
+            {
+                skip -= file.listed.size();
+                continue;
+            }
+            std::ifstream stream(file.path, std::ios::binary);
+            if (!stream.is_open())
+            {
+                return false;
+            }
+            std::string line;
+            for (size_t i = skip; i < file.listed.size() && top > 0; i++)
+            {
+                const Entry& entry = file.entries[file.listed[i]];
+                if (!readLine(stream, entry.offset, line))
+                {
+                    return false;
+                }
+                top--;
+                if (!callback(entry.id, line))
+                {
+                    return true;
+                }
+            }
+            skip = 0;
+        }
+        return true;
+    }
+
+    // Reads the first entry, oldest first, with the given ID, whether it's
+    // listed in the collection or not.  Returns false if there isn't one.
+    bool readEntry(const std::string& id, std::string& line)
+    {
+        update();
+        for (const File& file : files)
+        {
+            auto it = file.byId.find(id);
+            if (it == file.byId.end())
+            {
+                continue;
+            }
+            std::ifstream stream(file.path, std::ios::binary);
+            return stream.is_open() &&
+                   readLine(stream, file.entries[it->second].offset, line);
+        }
+        return false;
+    }
+
+    EventLogIndexStats getStats() const
+    {
+        EventLogIndexStats current = stats;
+        current.files = files.size();
+        for (const File& file : files)
+        {
+            current.lines += file.entries.size();
+        }
+        return current;
+    }
+
+  private:
+    // What stat says about a file, to tell when it has changed
+    struct Stamp
+    {
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        uint64_t size = 0;
+        int64_t mtimeSec = 0;
+        int64_t mtimeNsec = 0;
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    struct Entry
+    {
+        uint64_t offset = 0;
+        std::string id;
+    };
+
+    struct File
+    {
+        std::filesystem::path path;
+        // As the file was when it was last read
+        Stamp stamp;
+        // Bytes up to the end of the last complete line
+        uint64_t indexed = 0;
+        std::vector<Entry> entries;
+        // Indexes into entries of the lines listed in the collection
+        std::vector<size_t> listed;
+        // The first entry with each ID
+        std::unordered_map<std::string, size_t> byId;
+        // State for making IDs unique within the file
+        std::time_t prevTs = 0;
+        size_t tsIndex = 0;
+    };
+
+    static bool readStamp(const std::filesystem::path& path, Stamp& out)
+    {
+        struct stat st = {};
+        if (stat(path.c_str(), &st) != 0)
+        {
+            return false;
+        }
+        out.device = static_cast<uint64_t>(st.st_dev);
+        out.inode = static_cast<uint64_t>(st.st_ino);
+        out.size = static_cast<uint64_t>(st.st_size);
+        out.mtimeSec = static_cast<int64_t>(st.st_mtim.tv_sec);
+        out.mtimeNsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
+        return true;
+    }
+
+    static bool readLine(std::ifstream& stream, uint64_t offset,
+                         std::string& line)
+    {
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(offset));
+        return static_cast<bool>(std::getline(stream, line));
+    }
+
+    // Lines that name a MessageId no registry has are left out of the
+    // collection
+    static bool isListed(std::string_view line)
+    {
+        // The redfish log format is "<Timestamp> <MessageId>,<MessageArgs>"
+        size_t space = line.find(' ');
+        if (space == std::string_view::npos)
+        {
+            return true;
+        }
+        size_t entryStart = line.find_first_not_of(' ', space);
+        if (entryStart == std::string_view::npos)
+        {
+            return true;
+        }
+        std::string_view messageId = line.substr(entryStart);
+        messageId = messageId.substr(0, messageId.find(','));
+        return registries::getMessage(messageId) != nullptr;
+    }
+
+    static void addLine(File& file, uint64_t offset, const std::string& line)
+    {
+        // Get the entry timestamp
+        std::time_t curTs = 0;
+        std::tm timeStruct = {};
+        std::istringstream entryStream(line);
+        if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
+        {
+            curTs = std::mktime(&timeStruct);
+        }
+        // If the timestamp isn't unique, increment the index
+        if (!file.entries.empty() && curTs == file.prevTs)
+        {
+            file.tsIndex++;
+        }
+        else
+        {
+            file.tsIndex = 0;
+        }
+        file.prevTs = curTs;
+
+        std::string id = std::to_string(curTs);
+        if (file.tsIndex > 0)
+        {
+            id += "_" + std::to_string(file.tsIndex);
+        }
+        size_t position = file.entries.size();
+        if (isListed(line))
+        {
+            file.listed.push_back(position);
+        }
+        file.byId.try_emplace(id, position);
+        file.entries.emplace_back(Entry{offset, std::move(id)});
+    }
+
+    void readAppended(File& file, uint64_t size)
+    {
+        if (size < file.indexed)
+        {
+            BMCWEB_LOG_DEBUG("{} was truncated, reading it again",
+                             file.path.string());
+            File fresh;
+            fresh.path = file.path;
+            fresh.stamp = file.stamp;
+            file = std::move(fresh);
+            stats.reindexed++;
+        }
+        if (size == file.indexed)
+        {
+            return;
+        }
+        std::ifstream stream(file.path, std::ios::binary);
+        if (!stream.is_open())
+        {
+            return;
+        }
+        stream.seekg(static_cast<std::streamoff>(file.indexed));
+
+        std::array<char, 65536> buffer{};
+        std::string line;
+        uint64_t lineStart = file.indexed;
+        uint64_t position = file.indexed;
+        while (stream)
+        {
+            stream.read(buffer.data(), buffer.size());
+            std::string_view chunk(buffer.data(),
+                                   static_cast<size_t>(stream.gcount()));
+            stats.bytesRead += chunk.size();
+            while (!chunk.empty())
+            {
+                size_t newline = chunk.find('\n');
+                if (newline == std::string_view::npos)
+                {
+                    line.append(chunk);
+                    position += chunk.size();
+                    break;
+                }
+                line.append(chunk.substr(0, newline));
+                position += newline + 1;
+                chunk.remove_prefix(newline + 1);
+                addLine(file, lineStart, line);
+                line.clear();
+                lineStart = position;
+            }
+        }
+        // A line still being written is picked up once it's complete
+        file.indexed = lineStart;
+    }
+
+    // Whether the directory, and each file, are as they were when last read
+    bool isCurrent() const
+    {
+        Stamp current;
+        if (!readStamp(dir, current) || current != dirStamp)
+        {
+            return false;
+        }
+        return std::ranges::all_of(files, [](const File& file) {
+            Stamp now;
+            return readStamp(file.path, now) && now == file.stamp;
+        });
+    }
+
+    void update()
+    {
+        if (!stale && isCurrent())
+        {
+            return;
+        }
+        stale = false;
+        dirStamp = Stamp();
+        readStamp(dir, dirStamp);
+
+        std::vector<std::filesystem::path> paths;
+        std::error_code ec;
+        for (const std::filesystem::directory_entry& dirEnt :
+             std::filesystem::directory_iterator(dir, ec))
+        {
+            if (dirEnt.path().filename().string().starts_with(prefix))
+            {
+                paths.emplace_back(dirEnt.path());
+            }
+        }
+        // As the log files rotate, they are appended with a ".#" that is
+        // higher for the older logs, so sorting in descending order puts
+        // them oldest first, with the live file last
+        std::ranges::sort(paths, std::greater<>());
+
+        std::vector<File> current;
+        current.reserve(paths.size());
+        for (const std::filesystem::path& path : paths)
+        {
+            Stamp stamp;
+            if (!readStamp(path, stamp))
+            {
+                continue;
+            }
+            auto known = std::ranges::find_if(
+                files, [&stamp](const File& file) {
+                return file.stamp.device == stamp.device &&
+                       file.stamp.inode == stamp.inode;
+            });
+            if (known != files.end())
+            {
+                current.emplace_back(std::move(*known));
+                files.erase(known);
+            }
+            else
+            {
+                current.emplace_back();
+            }
+            current.back().path = path;
+            current.back().stamp = stamp;
+            readAppended(current.back(), stamp.size);
+        }
+        files = std::move(current);
+
+        listedCount = 0;
+        for (const File& file : files)
+        {
+            listedCount += file.listed.size();
+        }
+    }
+
+    std::filesystem::path dir;
+    std::string prefix;
+    bool stale = true;
+    Stamp dirStamp;
+    // Oldest file first
+    std::vector<File> files;
+    size_t listedCount = 0;
+    EventLogIndexStats stats;
+};
+
+} // namespace redfish
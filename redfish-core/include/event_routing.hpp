@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief Finds the subscriptions an event is sent to without looking at
+ * every subscription.
+ *
+ * Each subscription is filed under the ResourceTypes, RegistryPrefixes and
+ * MessageIds it asked for, so an event finds its subscribers with a handful of
+ * hash lookups however many subscriptions there are.  Subscriptions are filed
+ * in exactly one bucket for each kind of event, so no subscription is found
+ * twice.  Kept up to date by EventServiceManager as subscriptions come and go.
+ */
+class EventRouting
+{
+  public:
+    // Files a subscription.  Only subscriptions with eventLogs set are sent
+    // the Redfish event log entries.
+    void add(const std::string& id, bool eventLogs,
+             const std::vector<std::string>& resourceTypes,
+             const std::vector<std::string>& registryPrefixes,
+             const std::vector<std::string>& registryMsgIds)
+    {
+        remove(id);
+        Filters& filters = subscriptions[id];
+        filters.eventLogs = eventLogs;
+        filters.resourceTypes = resourceTypes;
+        filters.registryPrefixes = registryPrefixes;
+        filters.registryMsgIds = registryMsgIds;
+        update(id, filters, &EventRouting::insert);
+    }
+
+    void remove(const std::string& id)
+    {
+        auto it = subscriptions.find(id);
+        if (it == subscriptions.end())
+        {
+            return;
+        }
+        update(id, it->second, &EventRouting::erase);
+        subscriptions.erase(it);
+    }
+
+    size_t size() const
+    {
+        return subscriptions.size();
+    }
+
+    // Subscriptions sent events about a resource of the given type
+    std::vector<std::string> matchResourceType(std::string_view resType) const
+    {
+        std::vector<std::string> ids = anyResourceType;
+        append(byResourceType, resType, ids);
+        return ids;
+    }
+
+    // Subscriptions sent the event log entries with the given registry prefix
+    // and message key
+    std::vector<std::string> matchLogEntry(std::string_view registryPrefix,
+                                           std::string_view messageKey) const
+    {
+        std::vector<std::string> ids = anyLogEntry;
+        append(byRegistryPrefix, registryPrefix, ids);
+        append(byMessageKey, messageKey, ids);
+        if (!byPrefixAndKey.empty())
+        {
+            std::string key(registryPrefix);
+            key += '.';
+            key += messageKey;
+            append(byPrefixAndKey, key, ids);
+        }
+        return ids;
+    }
+
+  private:
+    struct Filters
+    {
+        bool eventLogs = false;
+        std::vector<std::string> resourceTypes;
+        std::vector<std::string> registryPrefixes;
+        std::vector<std::string> registryMsgIds;
+    };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    using Routes = std::unordered_map<std::string, std::vector<std::string>,
+                                      StringHash, std::equal_to<>>;
+    using Change = void (*)(std::vector<std::string>&, const std::string&);
+
+    static void insert(std::vector<std::string>& ids, const std::string& id)
+    {
+        // Filters can name the same thing twice
+        if (std::ranges::find(ids, id) == ids.end())
+        {
+            ids.emplace_back(id);
+        }
+    }
+
+    static void erase(std::vector<std::string>& ids, const std::string& id)
+    {
+        std::erase(ids, id);
+    }
+
+    static void change(Routes& routes, const std::string& key,
+                       const std::string& id, Change how)
+    {
+        std::vector<std::string>& ids = routes[key];
+        how(ids, id);
+        if (ids.empty())
+        {
+            routes.erase(key);
+        }
+    }
+
+    static void append(const Routes& routes, std::string_view key,
+                       std::vector<std::string>& ids)
+    {
+        auto it = routes.find(key);
+        if (it != routes.end())
+        {
+            ids.insert(ids.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Adds or removes a subscription from the buckets its filters pick.  An
+    // empty filter list means everything is sent.
+    void update(const std::string& id, const Filters& filters, Change how)
+    {
+        if (filters.resourceTypes.empty())
+        {
+            how(anyResourceType, id);
+        }
+        for (const std::string& resType : filters.resourceTypes)
+        {
+            change(byResourceType, resType, id, how);
+        }
+
+        if (!filters.eventLogs)
+        {
+            return;
+        }
+        if (filters.registryPrefixes.empty() && filters.registryMsgIds.empty())
+        {
+            how(anyLogEntry, id);
+        }
+        else if (filters.registryMsgIds.empty())
+        {
+            for (const std::string& prefix : filters.registryPrefixes)
+            {
+                change(byRegistryPrefix, prefix, id, how);
+            }
+        }
+        else if (filters.registryPrefixes.empty())
+        {
+            for (const std::string& messageKey : filters.registryMsgIds)
+            {
+                change(byMessageKey, messageKey, id, how);
+            }
+        }
+        else
+        {
+            for (const std::string& prefix : filters.registryPrefixes)
+            {
+                for (const std::string& messageKey : filters.registryMsgIds)
+                {
+                    change(byPrefixAndKey, prefix + '.' + messageKey, id,
+                           how);
+                }
+            }
+        }
+    }
+
+    std::unordered_map<std::string, Filters> subscriptions;
+
+    // Subscriptions without ResourceTypes, and those with
+    std::vector<std::string> anyResourceType;
+    Routes byResourceType;
+
+    // Event log subscriptions without RegistryPrefixes or MessageIds, those
+    // with only one of them, and those with both
+    std::vector<std::string> anyLogEntry;
+    Routes byRegistryPrefix;
+    Routes byMessageKey;
+    Routes byPrefixAndKey;
+};
+
+} // namespace redfish
@@ -16,6 +16,9 @@
 #pragma once
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
+#include "event_batch.hpp"
+#include "event_log_index.hpp"
+#include "event_routing.hpp"
 #include "event_service_store.hpp"
 #include "http_client.hpp"
 #include "metric_report.hpp"
@@ -31,12 +34,14 @@
 #include <sys/inotify.h>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/url/format.hpp>
 #include <boost/url/url_view_base.hpp>
 #include <sdbusplus/bus/match.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
@@ -57,9 +62,13 @@ static constexpr const char* subscriptionTypeSSE = "SSE";
 static constexpr const char* eventServiceFile =
     "/var/lib/bmcweb/eventservice_config.json";
 
-static constexpr const uint8_t maxNoOfSubscriptions = 20;
+static constexpr const size_t maxNoOfSubscriptions =
+    static_cast<size_t>(BMCWEB_MAX_EVENT_SUBSCRIPTIONS);
 static constexpr const uint8_t maxNoOfSSESubscriptions = 10;
 
+// Events held for one batch interval are sent early once there are this many
+static constexpr const size_t maxBatchedEvents = 100;
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static std::optional<boost::asio::posix::stream_descriptor> inotifyConn;
 static constexpr const char* redfishEventLogDir = "/var/log";
@@ -284,10 +293,16 @@ class Subscription : public persistent_data::UserSubscription
 
     bool sendEvent(std::string&& msg)
     {
-        persistent_data::EventServiceConfig eventServiceConfig =
-            persistent_data::EventServiceStore::getInstance()
-                .getEventServiceConfig();
-        if (!eventServiceConfig.enabled)
+        return sendEvent(std::make_shared<const std::string>(std::move(msg)));
+    }
+
+    // Sends an Event, which may be shared with other subscriptions.  Push
+    // style subscriptions send the shared string itself.
+    bool sendEvent(const std::shared_ptr<const std::string>& msg)
+    {
+        if (!persistent_data::EventServiceStore::getInstance()
+                 .getEventServiceConfig()
+                 .enabled)
         {
             return false;
         }
@@ -295,7 +310,7 @@ class Subscription : public persistent_data::UserSubscription
         // A connection pool will be created if one does not already exist
         if (client)
         {
-            client->sendData(std::move(msg), destinationUrl, httpHeaders,
+            client->sendData(msg, destinationUrl, httpHeaders,
                              boost::beast::http::verb::post);
             return true;
         }
@@ -303,7 +318,7 @@ class Subscription : public persistent_data::UserSubscription
         if (sseConn != nullptr)
         {
             eventSeqNum++;
-            sseConn->sendEvent(std::to_string(eventSeqNum), msg);
+            sseConn->sendEvent(std::to_string(eventSeqNum), *msg);
         }
         return true;
     }
@@ -335,41 +350,20 @@ class Subscription : public persistent_data::UserSubscription
         return sendEvent(std::move(strMsg));
     }
 
-    void filterAndSendEventLogs(
-        const std::vector<EventLogObjectsType>& eventRecords)
+    // Sends the given event log entries, which EventRouting has already
+    // matched against this subscription's filters
+    void sendEventLogs(const std::vector<EventLogObjectsType>& eventRecords,
+                       const std::vector<size_t>& indexes)
     {
         nlohmann::json logEntryArray;
-        for (const EventLogObjectsType& logEntry : eventRecords)
+        for (size_t index : indexes)
         {
+            const EventLogObjectsType& logEntry = eventRecords[index];
             const std::string& idStr = std::get<0>(logEntry);
             const std::string& timestamp = std::get<1>(logEntry);
             const std::string& messageID = std::get<2>(logEntry);
-            const std::string& registryName = std::get<3>(logEntry);
-            const std::string& messageKey = std::get<4>(logEntry);
             const std::vector<std::string>& messageArgs = std::get<5>(logEntry);
 
-            // If registryPrefixes list is empty, don't filter events
-            // send everything.
-            if (!registryPrefixes.empty())
-            {
-                auto obj = std::ranges::find(registryPrefixes, registryName);
-                if (obj == registryPrefixes.end())
-                {
-                    continue;
-                }
-            }
-
-            // If registryMsgIds list is empty, don't filter events
-            // send everything.
-            if (!registryMsgIds.empty())
-            {
-                auto obj = std::ranges::find(registryMsgIds, messageKey);
-                if (obj == registryMsgIds.end())
-                {
-                    continue;
-                }
-            }
-
             std::vector<std::string_view> messageArgsView(messageArgs.begin(),
                                                           messageArgs.end());
 
@@ -518,6 +512,14 @@ class EventServiceManager
 
     boost::asio::io_context& ioc;
 
+    // Which subscriptions each event is sent to
+    EventRouting routing;
+
+    // Events waiting for the batch interval to end
+    EventBatch eventBatch;
+    boost::asio::steady_timer batchTimer;
+    bool batchTimerRunning = false;
+
   public:
     EventServiceManager(const EventServiceManager&) = delete;
     EventServiceManager& operator=(const EventServiceManager&) = delete;
@@ -525,7 +527,8 @@ class EventServiceManager
     EventServiceManager& operator=(EventServiceManager&&) = delete;
     ~EventServiceManager() = default;
 
-    explicit EventServiceManager(boost::asio::io_context& iocIn) : ioc(iocIn)
+    explicit EventServiceManager(boost::asio::io_context& iocIn) :
+        ioc(iocIn), batchTimer(iocIn)
     {
         // Load config from persist store.
         initConfig();
@@ -586,6 +589,7 @@ class EventServiceManager
                 BMCWEB_LOG_ERROR("Failed to add subscription");
             }
             subscriptionsMap.insert(std::pair(subValue->id, subValue));
+            addRoutes(subValue->id, *subValue);
 
             updateNoOfSubscribersCount();
 
@@ -784,6 +788,13 @@ class EventServiceManager
         }
     }
 
+    void addRoutes(const std::string& id, const Subscription& subValue)
+    {
+        routing.add(id, subValue.eventFormatType == eventFormatType,
+                    subValue.resourceTypes, subValue.registryPrefixes,
+                    subValue.registryMsgIds);
+    }
+
     std::shared_ptr<Subscription> getSubscription(const std::string& id)
     {
         auto obj = subscriptionsMap.find(id);
@@ -843,6 +854,7 @@ class EventServiceManager
         newSub->metricReportDefinitions = subValue->metricReportDefinitions;
         persistent_data::EventServiceStore::getInstance()
             .subscriptionsConfigMap.emplace(newSub->id, newSub);
+        addRoutes(id, *subValue);
 
         updateNoOfSubscribersCount();
 
@@ -878,6 +890,7 @@ class EventServiceManager
         if (obj != subscriptionsMap.end())
         {
             subscriptionsMap.erase(obj);
+            routing.remove(id);
             auto obj2 = persistent_data::EventServiceStore::getInstance()
                             .subscriptionsConfigMap.find(id);
             persistent_data::EventServiceStore::getInstance()
@@ -898,6 +911,7 @@ class EventServiceManager
                 persistent_data::EventServiceStore::getInstance()
                     .subscriptionsConfigMap.erase(
                         it->second->getSubscriptionId());
+                routing.remove(it->first);
                 it = subscriptionsMap.erase(it);
                 return;
             }
@@ -952,61 +966,62 @@ class EventServiceManager
             BMCWEB_LOG_DEBUG("EventService disabled or no Subscriptions.");
             return;
         }
-        nlohmann::json eventRecord = nlohmann::json::array();
 
-        eventMessage["EventId"] = eventId;
-        // MemberId is 0 : since we are sending one event record.
-        eventMessage["MemberId"] = 0;
+        // Subscriptions without ResourceTypes are sent everything
+        std::vector<std::string> subscribed =
+            routing.matchResourceType(resType);
+        if (subscribed.empty())
+        {
+            BMCWEB_LOG_INFO("No subscriptions to ResourceType {}", resType);
+            return;
+        }
+
+        eventMessage["EventId"] = eventId++;
         eventMessage["EventTimestamp"] =
             redfish::time_utils::getDateTimeOffsetNow().first;
         eventMessage["OriginOfCondition"] = origin;
+        eventBatch.add(std::move(eventMessage), subscribed);
 
-        eventRecord.emplace_back(std::move(eventMessage));
-
-        for (const auto& it : subscriptionsMap)
+        if (BMCWEB_EVENT_BATCH_INTERVAL == 0 ||
+            eventBatch.size() >= maxBatchedEvents)
         {
-            std::shared_ptr<Subscription> entry = it.second;
-            bool isSubscribed = false;
-            // Search the resourceTypes list for the subscription.
-            // If resourceTypes list is empty, don't filter events
-            // send everything.
-            if (!entry->resourceTypes.empty())
-            {
-                for (const auto& resource : entry->resourceTypes)
-                {
-                    if (resType == resource)
-                    {
-                        BMCWEB_LOG_INFO(
-                            "ResourceType {} found in the subscribed list",
-                            resource);
-                        isSubscribed = true;
-                        break;
-                    }
-                }
-            }
-            else // resourceTypes list is empty.
+            flushEvents();
+            return;
+        }
+        if (batchTimerRunning)
+        {
+            return;
+        }
+        batchTimerRunning = true;
+        batchTimer.expires_after(
+            std::chrono::milliseconds(BMCWEB_EVENT_BATCH_INTERVAL));
+        batchTimer.async_wait([](const boost::system::error_code& ec) {
+            EventServiceManager& self = EventServiceManager::getInstance();
+            self.batchTimerRunning = false;
+            if (ec)
             {
-                isSubscribed = true;
+                BMCWEB_LOG_ERROR("Event batch timer failed: {}", ec.message());
+                return;
             }
-            if (isSubscribed)
-            {
-                nlohmann::json msgJson;
-
-                msgJson["@odata.type"] = "#Event.v1_4_0.Event";
-                msgJson["Name"] = "Event Log";
-                msgJson["Id"] = eventId;
-                msgJson["Events"] = eventRecord;
+            self.flushEvents();
+        });
+    }
 
-                std::string strMsg = msgJson.dump(
-                    2, ' ', true, nlohmann::json::error_handler_t::replace);
-                entry->sendEvent(std::move(strMsg));
-                eventId++; // increment the eventId
-            }
-            else
+    // Sends the batched events, serializing each distinct Event once
+    void flushEvents()
+    {
+        size_t count = eventBatch.size();
+        size_t payloads = eventBatch.flush(
+            eventId, [this](const std::string& id,
+                            const std::shared_ptr<const std::string>& msg) {
+            auto it = subscriptionsMap.find(id);
+            if (it != subscriptionsMap.end())
             {
-                BMCWEB_LOG_INFO("Not subscribed to this resource");
+                it->second->sendEvent(msg);
             }
-        }
+        });
+        BMCWEB_LOG_DEBUG("Sent {} events as {} distinct Events", count,
+                         payloads);
     }
 
     void resetRedfishFilePosition()
@@ -1104,12 +1119,25 @@ class EventServiceManager
             return;
         }
 
-        for (const auto& it : subscriptionsMap)
+        // The entries each subscription is sent, in the order they were
+        // logged
+        boost::container::flat_map<std::string, std::vector<size_t>>
+            subscribed;
+        for (size_t i = 0; i < eventRecords.size(); i++)
         {
-            std::shared_ptr<Subscription> entry = it.second;
-            if (entry->eventFormatType == "Event")
+            for (const std::string& id :
+                 routing.matchLogEntry(std::get<3>(eventRecords[i]),
+                                       std::get<4>(eventRecords[i])))
+            {
+                subscribed[id].push_back(i);
+            }
+        }
+        for (const auto& [id, indexes] : subscribed)
+        {
+            auto it = subscriptionsMap.find(id);
+            if (it != subscriptionsMap.end())
             {
-                entry->filterAndSendEventLogs(eventRecords);
+                it->second->sendEventLogs(eventRecords, indexes);
             }
         }
     }
@@ -1131,6 +1159,8 @@ class EventServiceManager
                 BMCWEB_LOG_ERROR("Callback Error: {}", ec.message());
                 return;
             }
+            // The log files were written, rotated or removed
+            EventLogIndex::getInstance().changed();
             std::size_t index = 0;
             while ((index + iEventSize) <= bytesTransferred)
             {
@@ -4,10 +4,95 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
 namespace redfish
 {
 
+// Looks up a property of a collection member, for handlers that evaluate a
+// delegated $filter before building the member as JSON.  Returns nullptr if
+// the member doesn't have the property.  The returned value needs to stay
+// valid until the evaluation is done.
+using FilterPropertyLookup =
+    std::function<const nlohmann::json*(std::string_view property)>;
+
+// A $filter compiled into a flat program, so that it can be evaluated against
+// many members without walking the AST again.  Literals are parsed once, and
+// every property the filter refers to is looked up once per member, however
+// many comparisons use it.
+class CompiledFilter
+{
+  public:
+    // A string parsed as Edm.DateTimeOffset
+    struct DateTime
+    {
+        int64_t usSinceEpoch = 0;
+    };
+
+    using Value = std::variant<std::monostate, double, int64_t, std::string,
+                               DateTime>;
+
+    explicit CompiledFilter(const filter_ast::LogicalAnd& filter);
+
+    // Properties the filter refers to, in the order they're looked up
+    const std::vector<std::string>& getProperties() const
+    {
+        return properties;
+    }
+
+    bool matches(const FilterPropertyLookup& lookup) const;
+
+    // Evaluates the filter against every member at once, a comparison at a
+    // time over all of them.  Element i is non zero if members[i] passes.
+    std::vector<uint8_t> matches(const nlohmann::json::array_t& members) const;
+
+  private:
+    struct Compiler;
+
+    enum class OpCode
+    {
+        Compare,
+        Not,
+        And,
+        Or,
+    };
+
+    struct Operand
+    {
+        // Index into properties, or unset for a literal
+        std::optional<size_t> property;
+        Value literal;
+    };
+
+    // Instructions are in postfix order, each one pushing its result
+    struct Instruction
+    {
+        OpCode op = OpCode::Compare;
+        filter_ast::ComparisonOpEnum comparison =
+            filter_ast::ComparisonOpEnum::Invalid;
+        Operand left;
+        Operand right;
+    };
+
+    // columns[p][i] is the value of properties[p] for member i
+    std::vector<uint8_t>
+        run(const std::vector<std::vector<Value>>& columns,
+            size_t count) const;
+
+    std::vector<std::string> properties;
+    std::vector<Instruction> program;
+};
+
+bool applyFilter(nlohmann::json& body, const CompiledFilter& filter);
+
 bool applyFilter(nlohmann::json& body,
                  const filter_ast::LogicalAnd& filterParam);
 
-}
+} // namespace redfish
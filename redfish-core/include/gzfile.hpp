@@ -2,214 +2,706 @@
 
 #include "logging.hpp"
 
+#include <sys/stat.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
-class GzFileReader
+// Splits host log text into entries.  An entry ends at a '\n' or a '\r',
+// with "\r\n" taken as a single delimiter.  Any other pair of delimiters in a
+// row is an entry of its own, "\n".  Text can be fed in chunks of any size,
+// and carries on from one file into the next.
+class HostLogParser
 {
   public:
-    bool gzGetLines(const std::string& filename, uint64_t skip, uint64_t top,
-                    std::vector<std::string>& logEntries, size_t& logCount)
+    // Called with the number of each entry, its text, and the offset in the
+    // chunk just past the delimiter that ended it.  Returns false to stop.
+    using EntryCallback = std::function<bool(
+        uint64_t number, std::string_view entry, size_t end)>;
+
+    HostLogParser() = default;
+
+    // Carries on just after a delimiter, with entries entries complete
+    HostLogParser(uint64_t entriesIn, char prevIn) :
+        entries(entriesIn), prev(prevIn)
+    {}
+
+    // Entries before keepFrom are passed to the callback without their text,
+    // so skipping them costs no more than finding where they end
+    void setKeepFrom(uint64_t keepFromIn)
     {
-        gzFile logStream = gzopen(filename.c_str(), "r");
-        if (logStream == nullptr)
+        keepFrom = keepFromIn;
+    }
+
+    bool feed(std::string_view chunk, const EntryCallback& callback)
+    {
+        size_t pos = 0;
+        while (pos < chunk.size())
         {
-            BMCWEB_LOG_ERROR("Can't open gz file: {}", filename);
+            size_t delimiter = chunk.find_first_of("\r\n", pos);
+            if (delimiter == std::string_view::npos)
+            {
+                append(chunk.substr(pos));
+                return true;
+            }
+            append(chunk.substr(pos, delimiter - pos));
+            bool ends = partial || prev != '\r' || chunk[delimiter] != '\n';
+            prev = chunk[delimiter];
+            pos = delimiter + 1;
+            if (ends && !emit(callback, pos))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Ends the text, so that an entry without a delimiter after it counts
+    void finish(const EntryCallback& callback)
+    {
+        if (partial)
+        {
+            emit(callback, 0);
+        }
+    }
+
+    uint64_t getEntries() const
+    {
+        return entries;
+    }
+
+    // Whether text has been fed since the last delimiter
+    bool hasPartial() const
+    {
+        return partial;
+    }
+
+    // The last character fed
+    char getPrev() const
+    {
+        return prev;
+    }
+
+    // Bytes of text held for the entry not yet ended
+    size_t kept() const
+    {
+        return text.size();
+    }
+
+  private:
+    void append(std::string_view piece)
+    {
+        if (piece.empty())
+        {
+            return;
+        }
+        partial = true;
+        prev = piece.back();
+        if (entries >= keepFrom)
+        {
+            text.append(piece);
+        }
+    }
+
+    bool emit(const EntryCallback& callback, size_t end)
+    {
+        std::string_view entry = partial ? std::string_view(text) : "\n";
+        partial = false;
+        bool more = callback(entries++, entry, end);
+        text.clear();
+        return more;
+    }
+
+    uint64_t entries = 0;
+    uint64_t keepFrom = 0;
+    bool partial = false;
+    char prev = 0;
+    std::string text;
+};
+
+// Where reading a host log file can start part way through, so that a page
+// of entries near the end doesn't mean inflating the whole file.  Every span
+// bytes of output, at the end of a deflate block, the position in the
+// compressed data and the 32K window before it are kept, as zlib's
+// examples/zran.c does, along with the first entry boundary after it.  Files
+// that aren't gzip compressed are read as they are, as gzread() would.
+class GzFileIndex
+{
+  public:
+    // Uncompressed bytes between access points, and so the most that's
+    // inflated without being returned when reading from one
+    static constexpr uint64_t span = 1024UL * 1024UL;
+    static constexpr size_t chunkSize = 64UL * 1024UL;
+    static constexpr size_t windowSize = 32768;
+
+    struct Point
+    {
+        // Offset of the first whole compressed byte, and how many bits of the
+        // byte before it are still to be read
+        uint64_t in = 0;
+        int bits = 0;
+        uint64_t out = 0;
+        // The output before out that the data after it can refer back to
+        std::vector<unsigned char> window;
+
+        // The first entry boundary at or after out, if the file has one.
+        // entries is the number of the entry that ends there, counting from
+        // the one that ends at the file's first delimiter.
+        bool hasBoundary = false;
+        uint64_t resume = 0;
+        uint64_t entries = 0;
+        char prev = 0;
+    };
+
+    // What putting the files of a log one after the other needs to know
+    struct Summary
+    {
+        uint64_t size = 0;
+        bool hasDelimiter = false;
+        // The file starts with a delimiter, and whether it's a '\n'
+        bool startsWithDelimiter = false;
+        bool startsWithNewline = false;
+        // Entries ended by the delimiters after the first one
+        uint64_t entriesAfterFirst = 0;
+        bool endsWithDelimiter = false;
+        char last = 0;
+    };
+
+    using ChunkCallback = std::function<bool(std::string_view chunk)>;
+
+    explicit GzFileIndex(std::filesystem::path pathIn) : path(std::move(pathIn))
+    {}
+
+    bool build()
+    {
+        if (!readIdentity(identity))
+        {
+            BMCWEB_LOG_ERROR("Can't stat host log file: {}", path.string());
+            return false;
+        }
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            BMCWEB_LOG_ERROR("Can't open gz file: {}", path.string());
             return false;
         }
+        std::array<char, 2> magic{};
+        file.read(magic.data(), magic.size());
+        compressed = file.gcount() == 2 && magic[0] == '\x1f' &&
+                     magic[1] == '\x8b';
+        file.clear();
+        file.seekg(0);
+
+        HostLogParser parser;
+        parser.setKeepFrom(std::numeric_limits<uint64_t>::max());
+        // Points waiting for the next entry boundary
+        size_t pending = 0;
+        uint64_t chunkStart = 0;
+        auto onEntry = [this, &parser, &pending, &chunkStart](
+                           uint64_t number, std::string_view, size_t end) {
+            for (; pending < points.size(); pending++)
+            {
+                Point& point = points[pending];
+                point.hasBoundary = true;
+                point.resume = chunkStart + end;
+                point.entries = number;
+                point.prev = parser.getPrev();
+            }
+            return true;
+        };
+        auto consume = [&](std::string_view chunk) {
+            if (chunk.empty())
+            {
+                return;
+            }
+            if (summary.size == 0)
+            {
+                summary.startsWithDelimiter = chunk[0] == '\n' ||
+                                              chunk[0] == '\r';
+                summary.startsWithNewline = chunk[0] == '\n';
+            }
+            chunkStart = summary.size;
+            parser.feed(chunk, onEntry);
+            summary.size += chunk.size();
+        };
 
-        if (!readFile(logStream, skip, top, logEntries, logCount))
+        bool ok = compressed ? indexCompressed(file, consume)
+                             : indexPlain(file, consume);
+        if (!ok)
         {
-            gzclose(logStream);
             return false;
         }
-        gzclose(logStream);
+        // The parser starts as if at the start of a log, so the file's first
+        // delimiter always ends an entry
+        summary.hasDelimiter = parser.getEntries() > 0;
+        if (summary.hasDelimiter)
+        {
+            summary.entriesAfterFirst = parser.getEntries() - 1;
+        }
+        summary.endsWithDelimiter = !parser.hasPartial();
+        summary.last = parser.getPrev();
+        BMCWEB_LOG_DEBUG("Indexed {}: {} bytes, {} access points",
+                         path.string(), summary.size, points.size());
         return true;
     }
 
-    std::string getLastMessage()
+    // Whether the file is still the one that was indexed
+    bool isCurrent() const
     {
-        return lastMessage;
+        Identity current;
+        return readIdentity(current) && current == identity;
     }
 
-  private:
-    std::string lastMessage;
-    std::string lastDelimiter;
-    size_t totalFilesSize = 0;
+    const std::filesystem::path& getPath() const
+    {
+        return path;
+    }
 
-    static void printErrorMessage(gzFile logStream)
+    const Summary& getSummary() const
     {
-        int errNum = 0;
-        const char* errMsg = gzerror(logStream, &errNum);
+        return summary;
+    }
 
-        BMCWEB_LOG_ERROR(
-            "Error reading gz compressed data.\nError Message: {}\nError Number: {}",
-            errMsg, errNum);
+    const std::vector<Point>& getPoints() const
+    {
+        return points;
     }
 
-    bool readFile(gzFile logStream, uint64_t skip, uint64_t top,
-                  std::vector<std::string>& logEntries, size_t& logCount)
+    // Calls callback with the uncompressed contents of the file, from point
+    // on, or from the start if point is null, until it returns false
+    bool read(const Point* point, const ChunkCallback& callback) const
     {
-        constexpr int bufferLimitSize = 1024;
-        do
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
         {
-            std::string bufferStr;
-            bufferStr.resize(bufferLimitSize);
-
-            int bytesRead = gzread(logStream, bufferStr.data(),
-                                   static_cast<unsigned int>(bufferStr.size()));
-            // On errors, gzread() shall return a value less than 0.
-            if (bytesRead < 0)
+            BMCWEB_LOG_ERROR("Can't open gz file: {}", path.string());
+            return false;
+        }
+        if (!compressed)
+        {
+            file.seekg(static_cast<std::streamoff>(
+                point == nullptr ? 0 : point->out));
+            return readAll(file, callback);
+        }
+        Inflater inflater;
+        if (point == nullptr)
+        {
+            // Adding 32 to the window bits detects the gzip header
+            if (!inflater.init(15 + 32))
             {
-                printErrorMessage(logStream);
                 return false;
             }
-            bufferStr.resize(static_cast<size_t>(bytesRead));
-            if (!hostLogEntryParser(bufferStr, skip, top, logEntries, logCount))
+            return inflateFrom(file, inflater, false, callback);
+        }
+        // From a point the data is raw deflate, with no header before it
+        if (!inflater.init(-15))
+        {
+            return false;
+        }
+        // A point part way through a byte starts with the rest of it
+        uint64_t in = point->in - (point->bits != 0 ? 1 : 0);
+        file.seekg(static_cast<std::streamoff>(in));
+        if (point->bits != 0)
+        {
+            int byte = file.get();
+            if (byte == std::char_traits<char>::eof())
             {
-                BMCWEB_LOG_ERROR("Error occurs during parsing host log.");
                 return false;
             }
-        } while (gzeof(logStream) != 1);
+            inflatePrime(&inflater.stream, point->bits,
+                         byte >> (8 - point->bits));
+        }
+        if (!point->window.empty())
+        {
+            inflateSetDictionary(&inflater.stream, point->window.data(),
+                                 static_cast<uInt>(point->window.size()));
+        }
+        return inflateFrom(file, inflater, true, callback);
+    }
+
+  private:
+    struct Identity
+    {
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        uint64_t size = 0;
+        int64_t mtimeSec = 0;
+        int64_t mtimeNsec = 0;
+
+        bool operator==(const Identity&) const = default;
+    };
+
+    // z_stream keeps a pointer to itself in its internal state, so this
+    // can't be moved once initialized
+    struct Inflater
+    {
+        Inflater() = default;
+        Inflater(const Inflater&) = delete;
+        Inflater(Inflater&&) = delete;
+        Inflater& operator=(const Inflater&) = delete;
+        Inflater& operator=(Inflater&&) = delete;
+
+        ~Inflater()
+        {
+            if (initialized)
+            {
+                inflateEnd(&stream);
+            }
+        }
+
+        bool init(int windowBits)
+        {
+            initialized = inflateInit2(&stream, windowBits) == Z_OK;
+            return initialized;
+        }
 
+        z_stream stream{};
+        bool initialized = false;
+    };
+
+    bool readIdentity(Identity& out) const
+    {
+        struct stat st = {};
+        if (stat(path.c_str(), &st) != 0)
+        {
+            return false;
+        }
+        out.device = static_cast<uint64_t>(st.st_dev);
+        out.inode = static_cast<uint64_t>(st.st_ino);
+        out.size = static_cast<uint64_t>(st.st_size);
+        out.mtimeSec = static_cast<int64_t>(st.st_mtim.tv_sec);
+        out.mtimeNsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
         return true;
     }
 
-    bool hostLogEntryParser(const std::string& bufferStr, uint64_t skip,
-                            uint64_t top, std::vector<std::string>& logEntries,
-                            size_t& logCount)
+    static size_t refill(std::ifstream& file, std::array<char, chunkSize>& in,
+                         z_stream& stream)
     {
-        // Assume we have 8 files, and the max size of each file is
-        // 16k, so define the max size as 256kb (double of 8 files *
-        // 16kb)
-        constexpr size_t maxTotalFilesSize = 262144;
+        file.read(in.data(), static_cast<std::streamsize>(in.size()));
+        stream.next_in = std::bit_cast<Bytef*>(in.data());
+        stream.avail_in = static_cast<uInt>(file.gcount());
+        return stream.avail_in;
+    }
 
-        // It may contain several log entry in one line, and
-        // the end of each log entry will be '\r\n' or '\r'.
-        // So we need to go through and split string by '\n' and '\r'
-        size_t pos = bufferStr.find_first_of("\n\r");
-        size_t initialPos = 0;
-        std::string newLastMessage;
+    static void printErrorMessage(const z_stream& stream, int ret)
+    {
+        BMCWEB_LOG_ERROR(
+            "Error reading gz compressed data.\nError Message: {}\nError Number: {}",
+            stream.msg == nullptr ? "" : stream.msg, ret);
+    }
 
-        while (pos != std::string::npos)
+    bool indexPlain(std::ifstream& file,
+                    const std::function<void(std::string_view)>& consume)
+    {
+        std::array<char, chunkSize> buffer{};
+        while (file)
         {
-            std::string logEntry = bufferStr.substr(initialPos,
-                                                    pos - initialPos);
-            // Since there might be consecutive delimiters like "\r\n", we need
-            // to filter empty strings.
-            if (!logEntry.empty())
+            file.read(buffer.data(),
+                      static_cast<std::streamsize>(buffer.size()));
+            size_t bytes = static_cast<size_t>(file.gcount());
+            uint64_t out = summary.size;
+            consume(std::string_view(buffer.data(), bytes));
+            if (bytes > 0 &&
+                (points.empty() || out + bytes - points.back().out > span))
             {
-                logCount++;
-                if (!lastMessage.empty())
-                {
-                    logEntry.insert(0, lastMessage);
-                    lastMessage.clear();
-                }
-                if (logCount > skip && logCount <= (skip + top))
-                {
-                    totalFilesSize += logEntry.size();
-                    if (totalFilesSize > maxTotalFilesSize)
-                    {
-                        BMCWEB_LOG_ERROR(
-                            "File size exceeds maximum allowed size of {}",
-                            maxTotalFilesSize);
-                        return false;
-                    }
-                    logEntries.push_back(logEntry);
-                }
+                Point point;
+                point.in = out + bytes;
+                point.out = out + bytes;
+                points.emplace_back(std::move(point));
             }
-            else
+        }
+        return true;
+    }
+
+    static bool readAll(std::ifstream& file, const ChunkCallback& callback)
+    {
+        std::array<char, chunkSize> buffer{};
+        while (file)
+        {
+            file.read(buffer.data(),
+                      static_cast<std::streamsize>(buffer.size()));
+            std::string_view chunk(buffer.data(),
+                                   static_cast<size_t>(file.gcount()));
+            if (!chunk.empty() && !callback(chunk))
             {
-                // Handle consecutive delimiter. '\r\n' act as a single
-                // delimiter, the other case like '\n\n', '\n\r' or '\r\r' will
-                // push back a "\n" as a log.
-                std::string delimiters;
-                if (pos > 0)
-                {
-                    delimiters = bufferStr.substr(pos - 1, 2);
-                }
-                // Handle consecutive delimiter but spilt between two files.
-                if (pos == 0 && !(lastDelimiter.empty()))
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool indexCompressed(std::ifstream& file,
+                         const std::function<void(std::string_view)>& consume)
+    {
+        Inflater inflater;
+        if (!inflater.init(15 + 32))
+        {
+            return false;
+        }
+        z_stream& stream = inflater.stream;
+        std::array<char, chunkSize> in{};
+        std::array<char, chunkSize> out{};
+        std::vector<unsigned char> history;
+        uint64_t totalIn = 0;
+        while (true)
+        {
+            if (stream.avail_in == 0 && refill(file, in, stream) == 0)
+            {
+                BMCWEB_LOG_ERROR("{} ends part way through", path.string());
+                return false;
+            }
+            uInt availIn = stream.avail_in;
+            stream.next_out = std::bit_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+            // Z_BLOCK returns at the end of each deflate block, where an
+            // access point can go
+            int ret = inflate(&stream, Z_BLOCK);
+            totalIn += availIn - stream.avail_in;
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            {
+                printErrorMessage(stream, ret);
+                return false;
+            }
+            std::string_view chunk(out.data(), out.size() - stream.avail_out);
+            consume(chunk);
+            history.insert(history.end(), chunk.begin(), chunk.end());
+            if (history.size() > windowSize)
+            {
+                history.erase(history.begin(),
+                              history.end() - windowSize);
+            }
+            if (ret == Z_STREAM_END)
+            {
+                // Another gzip member may follow
+                if (stream.avail_in == 0 && refill(file, in, stream) == 0)
                 {
-                    delimiters = lastDelimiter + bufferStr.substr(0, 1);
+                    return true;
                 }
-                if (delimiters != "\r\n")
+                inflateReset(&stream);
+                continue;
+            }
+            bool blockEnd = (stream.data_type & 128) != 0 &&
+                            (stream.data_type & 64) == 0;
+            if (blockEnd && (points.empty() ||
+                             summary.size - points.back().out > span))
+            {
+                Point point;
+                point.in = totalIn;
+                point.bits = stream.data_type & 7;
+                point.out = summary.size;
+                point.window = history;
+                points.emplace_back(std::move(point));
+            }
+        }
+    }
+
+    static bool inflateFrom(std::ifstream& file, Inflater& inflater, bool raw,
+                            const ChunkCallback& callback)
+    {
+        z_stream& stream = inflater.stream;
+        std::array<char, chunkSize> in{};
+        std::array<char, chunkSize> out{};
+        while (true)
+        {
+            if (stream.avail_in == 0 && refill(file, in, stream) == 0)
+            {
+                BMCWEB_LOG_ERROR("gz file ends part way through");
+                return false;
+            }
+            stream.next_out = std::bit_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+            int ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            {
+                printErrorMessage(stream, ret);
+                return false;
+            }
+            std::string_view chunk(out.data(), out.size() - stream.avail_out);
+            if (!chunk.empty() && !callback(chunk))
+            {
+                return true;
+            }
+            if (ret != Z_STREAM_END)
+            {
+                continue;
+            }
+            if (raw)
+            {
+                // Raw inflate leaves the gzip trailer unread
+                size_t trailer = 8;
+                while (trailer > 0)
                 {
-                    logCount++;
-                    if (logCount > skip && logCount <= (skip + top))
+                    if (stream.avail_in == 0 &&
+                        refill(file, in, stream) == 0)
                     {
-                        totalFilesSize++;
-                        if (totalFilesSize > maxTotalFilesSize)
-                        {
-                            BMCWEB_LOG_ERROR(
-                                "File size exceeds maximum allowed size of {}",
-                                maxTotalFilesSize);
-                            return false;
-                        }
-                        logEntries.emplace_back("\n");
+                        return true;
                     }
+                    uInt skip = std::min(static_cast<uInt>(trailer),
+                                         stream.avail_in);
+                    stream.next_in += skip;
+                    stream.avail_in -= skip;
+                    trailer -= skip;
                 }
             }
-            initialPos = pos + 1;
-            pos = bufferStr.find_first_of("\n\r", initialPos);
+            // Another gzip member may follow
+            if (stream.avail_in == 0 && refill(file, in, stream) == 0)
+            {
+                return true;
+            }
+            if (raw)
+            {
+                inflateReset2(&stream, 15 + 32);
+                raw = false;
+                continue;
+            }
+            inflateReset(&stream);
         }
+    }
+
+    std::filesystem::path path;
+    Identity identity;
+    bool compressed = false;
+    Summary summary;
+    std::vector<Point> points;
+};
 
-        // Store the last message
-        if (initialPos < bufferStr.size())
+// Reads the entries numbered skip to skip + top - 1 of a host log made up of
+// files, oldest first, and counts the entries in all of them.  Reading starts
+// at the last access point before the first entry wanted.
+inline bool readHostLogEntries(
+    const std::vector<std::shared_ptr<const GzFileIndex>>& files,
+    uint64_t skip, uint64_t top, std::vector<std::string>& logEntries,
+    size_t& logCount)
+{
+    // Assume we have 8 files, and the max size of each file is
+    // 16k, so define the max size as 256kb (double of 8 files *
+    // 16kb)
+    constexpr size_t maxTotalFilesSize = 262144;
+
+    // Number each file's entries from the entry its first delimiter ends,
+    // which depends on how the file before it ended
+    std::vector<uint64_t> bases(files.size());
+    uint64_t total = 0;
+    bool partial = false;
+    char prev = 0;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        const GzFileIndex::Summary& summary = files[i]->getSummary();
+        bases[i] = total;
+        if (summary.size == 0)
         {
-            newLastMessage = bufferStr.substr(initialPos);
+            continue;
         }
-        // If consecutive delimiter spilt by buffer or file, the last character
-        // must be the delimiter.
-        else if (initialPos == bufferStr.size())
+        if (!summary.hasDelimiter)
         {
-            lastDelimiter = std::string(1, bufferStr.back());
+            partial = true;
+            prev = summary.last;
+            continue;
         }
-        // If file doesn't contain any "\r" or "\n", initialPos should be zero
-        if (initialPos == 0)
+        if (partial || !summary.startsWithDelimiter || prev != '\r' ||
+            !summary.startsWithNewline)
         {
-            // Solved an edge case that the log doesn't in skip and top range,
-            // but consecutive files don't contain a single delimiter, this
-            // lastMessage becomes unnecessarily large. Since last message will
-            // prepend to next log, logCount need to plus 1
-            if ((logCount + 1) > skip && (logCount + 1) <= (skip + top))
-            {
-                lastMessage.insert(
-                    lastMessage.end(),
-                    std::make_move_iterator(newLastMessage.begin()),
-                    std::make_move_iterator(newLastMessage.end()));
+            bases[i]++;
+        }
+        total = bases[i] + summary.entriesAfterFirst;
+        partial = !summary.endsWithDelimiter;
+        prev = summary.last;
+    }
+    if (partial)
+    {
+        total++;
+    }
+    logCount = total;
+    if (top == 0 || skip >= total)
+    {
+        return true;
+    }
+    uint64_t end = skip + std::min(top, total - skip);
 
-                // Following the previous question, protect lastMessage don't
-                // larger than max total files size
-                size_t tmpMessageSize = totalFilesSize + lastMessage.size();
-                if (tmpMessageSize > maxTotalFilesSize)
-                {
-                    BMCWEB_LOG_ERROR(
-                        "File size exceeds maximum allowed size of {}",
-                        maxTotalFilesSize);
-                    return false;
-                }
+    size_t startFile = 0;
+    const GzFileIndex::Point* startPoint = nullptr;
+    HostLogParser parser;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        for (const GzFileIndex::Point& point : files[i]->getPoints())
+        {
+            if (!point.hasBoundary || bases[i] + point.entries > skip)
+            {
+                continue;
             }
+            startFile = i;
+            startPoint = &point;
+            parser = HostLogParser(bases[i] + point.entries, point.prev);
         }
-        else
+    }
+    parser.setKeepFrom(skip);
+
+    size_t totalSize = 0;
+    bool tooLarge = false;
+    auto onEntry = [&](uint64_t number, std::string_view entry, size_t) {
+        if (number < skip)
+        {
+            return true;
+        }
+        totalSize += entry.size();
+        if (totalSize > maxTotalFilesSize)
         {
-            if (!newLastMessage.empty())
+            tooLarge = true;
+            return false;
+        }
+        logEntries.emplace_back(entry);
+        return number + 1 < end;
+    };
+    for (size_t i = startFile; i < files.size(); i++)
+    {
+        const GzFileIndex::Point* point = i == startFile ? startPoint
+                                                         : nullptr;
+        uint64_t discard = point == nullptr ? 0 : point->resume - point->out;
+        bool more = true;
+        bool ok = files[i]->read(point, [&](std::string_view chunk) {
+            size_t skipped = static_cast<size_t>(
+                std::min<uint64_t>(discard, chunk.size()));
+            chunk.remove_prefix(skipped);
+            discard -= skipped;
+            more = parser.feed(chunk, onEntry);
+            if (totalSize + parser.kept() > maxTotalFilesSize)
             {
-                lastMessage = std::move(newLastMessage);
+                tooLarge = true;
+                more = false;
             }
+            return more;
+        });
+        if (!ok)
+        {
+            BMCWEB_LOG_ERROR("Error reading {}", files[i]->getPath().string());
+            return false;
+        }
+        if (!more)
+        {
+            break;
         }
-        return true;
     }
-
-  public:
-    GzFileReader() = default;
-    ~GzFileReader() = default;
-    GzFileReader(const GzFileReader&) = delete;
-    GzFileReader& operator=(const GzFileReader&) = delete;
-    GzFileReader(GzFileReader&&) = delete;
-    GzFileReader& operator=(GzFileReader&&) = delete;
-};
+    if (tooLarge)
+    {
+        BMCWEB_LOG_ERROR("File size exceeds maximum allowed size of {}",
+                         maxTotalFilesSize);
+        return false;
+    }
+    if (logEntries.size() < end - skip)
+    {
+        parser.finish(onEntry);
+    }
+    return true;
+}
@@ -168,6 +168,12 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
     }
 
     delegated = query_param::delegate(queryCapabilities, *queryOpt);
+    if (req.expandSubrequest)
+    {
+        // The request being expanded carries on from what's left
+        queryOpt->expandType = query_param::ExpandType::None;
+        queryOpt->expandLevel = 0;
+    }
     std::function<void(crow::Response&)> handler =
         asyncResp->res.releaseCompleteRequestHandler();
 
@@ -0,0 +1,419 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief The objects one service provides under /xyz/openbmc_project/sensors,
+ * in the shape GetManagedObjects returns them, so that they can be handed to
+ * the same code.  Objects are kept sorted by path, so that the object a
+ * signal is about can be found with a binary search.
+ */
+class SensorTable
+{
+  public:
+    explicit SensorTable(dbus::utility::ManagedObjectType&& objectsIn) :
+        objects(std::move(objectsIn))
+    {
+        std::ranges::sort(objects, {}, [](const auto& object) {
+            return std::string_view(object.first.str);
+        });
+    }
+
+    const dbus::utility::ManagedObjectType& getObjects() const
+    {
+        return objects;
+    }
+
+    void propertiesChanged(std::string_view path, const std::string& interface,
+                           const dbus::utility::DBusPropertiesMap& changed,
+                           const std::vector<std::string>& invalidated)
+    {
+        dbus::utility::DBusInterfacesMap* interfaces = findObject(path);
+        if (interfaces == nullptr)
+        {
+            // Not known yet, its InterfacesAdded will bring it in
+            return;
+        }
+        auto iface = std::ranges::find(
+            *interfaces, interface,
+            &std::pair<std::string, dbus::utility::DBusPropertiesMap>::first);
+        if (iface == interfaces->end())
+        {
+            return;
+        }
+        for (const auto& [name, value] : changed)
+        {
+            auto property = std::ranges::find(
+                iface->second, name,
+                &std::pair<std::string, dbus::utility::DbusVariantType>::first);
+            if (property == iface->second.end())
+            {
+                iface->second.emplace_back(name, value);
+                continue;
+            }
+            property->second = value;
+        }
+        for (const std::string& name : invalidated)
+        {
+            std::erase_if(iface->second, [&name](const auto& property) {
+                return property.first == name;
+            });
+        }
+    }
+
+    void interfacesAdded(const std::string& path,
+                         const dbus::utility::DBusInterfacesMap& added)
+    {
+        dbus::utility::DBusInterfacesMap* interfaces = findObject(path);
+        if (interfaces == nullptr)
+        {
+            auto it = std::ranges::lower_bound(
+                objects, std::string_view(path), {}, [](const auto& object) {
+                return std::string_view(object.first.str);
+            });
+            objects.emplace(it, sdbusplus::message::object_path(path), added);
+            return;
+        }
+        for (const auto& interface : added)
+        {
+            auto it = std::ranges::find(
+                *interfaces, interface.first,
+                &std::pair<std::string,
+                           dbus::utility::DBusPropertiesMap>::first);
+            if (it == interfaces->end())
+            {
+                interfaces->emplace_back(interface);
+                continue;
+            }
+            it->second = interface.second;
+        }
+    }
+
+    void interfacesRemoved(std::string_view path,
+                           const std::vector<std::string>& removed)
+    {
+        auto it = lowerBound(path);
+        if (it == objects.end() || it->first.str != path)
+        {
+            return;
+        }
+        std::erase_if(it->second, [&removed](const auto& interface) {
+            return std::ranges::find(removed, interface.first) !=
+                   removed.end();
+        });
+        if (it->second.empty())
+        {
+            objects.erase(it);
+        }
+    }
+
+    // An estimate of the heap memory held, for reporting
+    size_t memoryUsage() const
+    {
+        size_t bytes = objects.capacity() * sizeof(objects[0]);
+        for (const auto& [path, interfaces] : objects)
+        {
+            bytes += path.str.capacity();
+            bytes += interfaces.capacity() * sizeof(interfaces[0]);
+            for (const auto& [interface, properties] : interfaces)
+            {
+                bytes += interface.capacity();
+                bytes += properties.capacity() * sizeof(properties[0]);
+                for (const auto& [name, value] : properties)
+                {
+                    bytes += name.capacity();
+                    const std::string* str = std::get_if<std::string>(&value);
+                    if (str != nullptr)
+                    {
+                        bytes += str->capacity();
+                    }
+                }
+            }
+        }
+        return bytes;
+    }
+
+  private:
+    dbus::utility::ManagedObjectType::iterator lowerBound(std::string_view path)
+    {
+        return std::ranges::lower_bound(objects, path, {},
+                                        [](const auto& object) {
+            return std::string_view(object.first.str);
+        });
+    }
+
+    dbus::utility::DBusInterfacesMap* findObject(std::string_view path)
+    {
+        auto it = lowerBound(path);
+        if (it == objects.end() || it->first.str != path)
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    dbus::utility::ManagedObjectType objects;
+};
+
+struct SensorCacheStats
+{
+    size_t services = 0;
+    size_t objects = 0;
+    // Approximate heap memory held by the cached objects
+    size_t memoryBytes = 0;
+    // Signals applied to the cached objects
+    size_t updates = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+/**
+ * @brief Keeps the sensor objects of every sensor service resident, so that
+ * sensor collections are served from memory instead of a GetManagedObjects
+ * call to each service per request.
+ *
+ * A service's objects are read once, then kept current from its
+ * PropertiesChanged, InterfacesAdded and InterfacesRemoved signals.  D-Bus
+ * delivers a service's signals in the order it sends them, after any method
+ * reply sent before them, so signals that arrive before the initial read
+ * completes are already reflected in it.  Values that change without a
+ * signal are at most the configured ttl old, after which the service is
+ * read again.  Only used from the main io_context.
+ */
+class SensorCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const dbus::utility::ManagedObjectType&)>;
+    using Clock = std::chrono::steady_clock;
+
+    static SensorCache& getInstance()
+    {
+        static SensorCache cache{
+            std::chrono::seconds(BMCWEB_SENSOR_CACHE_TTL)};
+        return cache;
+    }
+
+    explicit SensorCache(std::chrono::seconds ttlIn) :
+        ttl(ttlIn),
+        propertiesChangedMatch(
+            *crow::connections::systemBus,
+            "type='signal',member='PropertiesChanged',"
+            "interface='org.freedesktop.DBus.Properties',"
+            "path_namespace='/xyz/openbmc_project/sensors'",
+            std::bind_front(&SensorCache::onPropertiesChanged, this)),
+        interfacesAddedMatch(
+            *crow::connections::systemBus,
+            "type='signal',member='InterfacesAdded',"
+            "interface='org.freedesktop.DBus.ObjectManager',"
+            "arg0namespace='/xyz/openbmc_project/sensors'",
+            std::bind_front(&SensorCache::onInterfacesAdded, this)),
+        interfacesRemovedMatch(
+            *crow::connections::systemBus,
+            "type='signal',member='InterfacesRemoved',"
+            "interface='org.freedesktop.DBus.ObjectManager',"
+            "arg0namespace='/xyz/openbmc_project/sensors'",
+            std::bind_front(&SensorCache::onInterfacesRemoved, this)),
+        nameOwnerChangedMatch(
+            *crow::connections::systemBus,
+            sdbusplus::bus::match::rules::nameOwnerChanged(),
+            std::bind_front(&SensorCache::onNameOwnerChanged, this))
+    {}
+
+    SensorCache(const SensorCache&) = delete;
+    SensorCache(SensorCache&&) = delete;
+    SensorCache& operator=(const SensorCache&) = delete;
+    SensorCache& operator=(SensorCache&&) = delete;
+    ~SensorCache() = default;
+
+    // Calls back with the objects service provides under
+    // /xyz/openbmc_project/sensors, as GetManagedObjects would
+    void getManagedObjects(const std::string& service, Callback&& callback)
+    {
+        auto it = services.find(service);
+        if (it != services.end() && Clock::now() - it->second.read < ttl)
+        {
+            stats.hits++;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [callback{std::move(callback)},
+                               table{it->second.table}]() {
+                callback(boost::system::error_code(), table->getObjects());
+            });
+            return;
+        }
+        stats.misses++;
+        crow::connections::systemBus->async_method_call(
+            [this, service, callback{std::move(callback)}](
+                const boost::system::error_code& ec,
+                const std::string& owner) mutable {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR("Couldn't find owner of {}: {}", service, ec);
+                callback(ec, dbus::utility::ManagedObjectType());
+                return;
+            }
+            readService(service, owner, std::move(callback));
+        },
+            "org.freedesktop.DBus", "/org/freedesktop/DBus",
+            "org.freedesktop.DBus", "GetNameOwner", service);
+    }
+
+    SensorCacheStats getStats() const
+    {
+        SensorCacheStats current = stats;
+        current.services = services.size();
+        for (const auto& [name, service] : services)
+        {
+            current.objects += service.table->getObjects().size();
+            current.memoryBytes += service.table->memoryUsage();
+        }
+        return current;
+    }
+
+  private:
+    struct Service
+    {
+        // Unique bus name, which signals are sent from
+        std::string owner;
+        std::shared_ptr<SensorTable> table;
+        Clock::time_point read;
+    };
+
+    void readService(const std::string& service, const std::string& owner,
+                     Callback&& callback)
+    {
+        sdbusplus::message::object_path sensorPath(
+            "/xyz/openbmc_project/sensors");
+        dbus::utility::getManagedObjects(
+            service, sensorPath,
+            [this, service, owner, callback{std::move(callback)}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& objects) {
+            if (ec)
+            {
+                callback(ec, objects);
+                return;
+            }
+            auto table = std::make_shared<SensorTable>(
+                dbus::utility::ManagedObjectType(objects));
+            services.insert_or_assign(service,
+                                      Service{owner, table, Clock::now()});
+            SensorCacheStats current = getStats();
+            BMCWEB_LOG_DEBUG(
+                "Sensor cache holds {} objects from {} services in {} bytes",
+                current.objects, current.services, current.memoryBytes);
+            callback(ec, table->getObjects());
+        });
+    }
+
+    SensorTable* findTable(std::string_view sender)
+    {
+        for (auto& [name, service] : services)
+        {
+            if (service.owner == sender)
+            {
+                return service.table.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        SensorTable* table = findTable(msg.get_sender());
+        if (table == nullptr)
+        {
+            return;
+        }
+        std::string interface;
+        dbus::utility::DBusPropertiesMap changed;
+        std::vector<std::string> invalidated;
+        msg.read(interface, changed, invalidated);
+        table->propertiesChanged(msg.get_path(), interface, changed,
+                                 invalidated);
+        stats.updates++;
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        SensorTable* table = findTable(msg.get_sender());
+        if (table == nullptr)
+        {
+            return;
+        }
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInterfacesMap interfaces;
+        msg.read(path, interfaces);
+        table->interfacesAdded(path.str, interfaces);
+        stats.updates++;
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        SensorTable* table = findTable(msg.get_sender());
+        if (table == nullptr)
+        {
+            return;
+        }
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        msg.read(path, interfaces);
+        table->interfacesRemoved(path.str, interfaces);
+        stats.updates++;
+    }
+
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        msg.read(name, oldOwner, newOwner);
+        // The service restarted or went away, so is read again on next use
+        for (auto it = services.begin(); it != services.end();)
+        {
+            if (it->first == name ||
+                (!oldOwner.empty() && it->second.owner == oldOwner))
+            {
+                it = services.erase(it);
+                continue;
+            }
+            it++;
+        }
+    }
+
+    std::chrono::seconds ttl;
+    boost::container::flat_map<std::string, Service> services;
+    SensorCacheStats stats;
+
+    sdbusplus::bus::match_t propertiesChangedMatch;
+    sdbusplus::bus::match_t interfacesAddedMatch;
+    sdbusplus::bus::match_t interfacesRemovedMatch;
+    sdbusplus::bus::match_t nameOwnerChangedMatch;
+};
+
+} // namespace redfish
@@ -5,14 +5,21 @@
 #include "error_messages.hpp"
 #include "http/utility.hpp"
 #include "human_sort.hpp"
+#include "utils/query_param.hpp"
 
+#include <boost/container/flat_map.hpp>
 #include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
+#include <sdbusplus/asio/property.hpp>
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <ranges>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace redfish
@@ -115,5 +122,343 @@ inline void
                        nlohmann::json::json_pointer("/Members"));
 }
 
+// Whether a collection handler that was delegated $expand should fill in its
+// members.  Members aren't under Links, so expanding only links leaves them
+// as references.
+inline bool expandsMembers(const query_param::Query& delegated)
+{
+    return delegated.expandType == query_param::ExpandType::NotLinks ||
+           delegated.expandType == query_param::ExpandType::Both;
+}
+
+/**
+ * @brief Returns an AsyncResp for filling in a single member of an expanded
+ *        collection.  Once it completes, the member's response replaces the
+ *        reference at index in the collection's Members, and any error is
+ *        propagated to the collection's response.
+ */
+inline std::shared_ptr<bmcweb::AsyncResp>
+    makeExpandedMemberResp(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           size_t index)
+{
+    auto memberResp = std::make_shared<bmcweb::AsyncResp>();
+    memberResp->res.setCompleteRequestHandler(
+        [asyncResp, index](crow::Response& res) {
+        query_param::propogateError(asyncResp->res, res);
+        if (!res.jsonValue.is_object() || res.jsonValue.empty())
+        {
+            return;
+        }
+        nlohmann::json::array_t* members =
+            asyncResp->res.jsonValue["Members"]
+                .get_ptr<nlohmann::json::array_t*>();
+        if (members == nullptr || index >= members->size())
+        {
+            return;
+        }
+        (*members)[index] = std::move(res.jsonValue);
+    });
+    return memberResp;
+}
+
+struct ExpandedMember
+{
+    // Last segment of the member's D-Bus path
+    std::string id;
+    std::string path;
+    // Every service that provides the member, and the interfaces each
+    // implements there
+    dbus::utility::MapperServiceMap services;
+};
+
+// What the services had to say about one member
+struct ExpandedMemberObjects
+{
+    // The member's interfaces and their properties, from each of its
+    // services, in the order of ExpandedMember::services
+    std::vector<dbus::utility::DBusInterfacesMap> interfaces;
+    // Objects directly below the member, for members that are made up of
+    // several objects.  Only found when a service implements ObjectManager.
+    dbus::utility::ManagedObjectType children;
+    // D-Bus calls still to answer before the member can be filled in
+    size_t outstanding = 0;
+};
+
+/**
+ * @brief Fills in one member of an expanded collection, the way the member's
+ *        own GET handler would.
+ *
+ * @param[i,o] memberResp  Response for the member alone
+ * @param[in]  member      The member's D-Bus object
+ * @param[in]  objects     Properties of the member's interfaces, and its
+ *             child objects
+ */
+using ExpandedMemberFiller = std::function<void(
+    const std::shared_ptr<bmcweb::AsyncResp>& memberResp,
+    const ExpandedMember& member, const ExpandedMemberObjects& objects)>;
+
+struct ExpandedCollection
+{
+    std::vector<ExpandedMember> members;
+    std::vector<ExpandedMemberObjects> objects;
+    ExpandedMemberFiller filler;
+};
+
+// A member, and which of its services an answer came from
+struct ExpandedMemberService
+{
+    size_t index;
+    size_t slot;
+};
+
+// Counts off one answer for a member, and fills it in once every service has
+// answered
+inline void expandedMemberAnswered(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::shared_ptr<ExpandedCollection>& collection, size_t index)
+{
+    ExpandedMemberObjects& objects = collection->objects[index];
+    if (--objects.outstanding != 0)
+    {
+        return;
+    }
+    collection->filler(makeExpandedMemberResp(asyncResp, index),
+                       collection->members[index], objects);
+}
+
+// Used when a service has no ObjectManager, asking for the properties of each
+// interface the member implements there instead
+inline void getExpandedMembersProperties(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::shared_ptr<ExpandedCollection>& collection,
+    const std::vector<ExpandedMemberService>& found)
+{
+    for (const ExpandedMemberService& member : found)
+    {
+        const auto& [service, interfaces] =
+            collection->members[member.index].services[member.slot];
+        std::vector<std::string> wanted;
+        for (const std::string& interface : interfaces)
+        {
+            if (!interface.starts_with("org.freedesktop.DBus."))
+            {
+                wanted.push_back(interface);
+            }
+        }
+        if (wanted.empty())
+        {
+            expandedMemberAnswered(asyncResp, collection, member.index);
+            continue;
+        }
+        collection->objects[member.index].outstanding += wanted.size() - 1;
+        for (const std::string& interface : wanted)
+        {
+            sdbusplus::asio::getAllProperties(
+                *crow::connections::systemBus, service,
+                collection->members[member.index].path, interface,
+                [asyncResp, collection, member, interface](
+                    const boost::system::error_code& ec,
+                    const dbus::utility::DBusPropertiesMap& properties) {
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR("DBUS response error {}", ec);
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                collection->objects[member.index]
+                    .interfaces[member.slot]
+                    .emplace_back(interface, properties);
+                expandedMemberAnswered(asyncResp, collection, member.index);
+            });
+        }
+    }
+}
+
+inline void afterGetExpandedManagedObjects(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::shared_ptr<ExpandedCollection>& collection,
+    const std::vector<ExpandedMemberService>& found,
+    const dbus::utility::ManagedObjectType& objects)
+{
+    boost::container::flat_map<std::string_view, ExpandedMemberService>
+        byPath;
+    for (const ExpandedMemberService& member : found)
+    {
+        byPath.emplace(collection->members[member.index].path, member);
+    }
+
+    boost::container::flat_map<std::string_view, ExpandedMemberService>
+        missing = byPath;
+    for (const auto& [path, interfaces] : objects)
+    {
+        auto it = byPath.find(path.str);
+        if (it != byPath.end())
+        {
+            collection->objects[it->second.index].interfaces[it->second.slot] =
+                interfaces;
+            missing.erase(path.str);
+            continue;
+        }
+        it = byPath.find(path.parent_path().str);
+        if (it != byPath.end())
+        {
+            collection->objects[it->second.index].children.emplace_back(
+                path, interfaces);
+        }
+    }
+
+    // The mapper and the service disagree, so ask after what's left one by one
+    std::vector<ExpandedMemberService> remaining;
+    for (const auto& [path, member] : missing)
+    {
+        remaining.push_back(member);
+    }
+    for (const auto& [path, member] : byPath)
+    {
+        if (!missing.contains(path))
+        {
+            expandedMemberAnswered(asyncResp, collection, member.index);
+        }
+    }
+    getExpandedMembersProperties(asyncResp, collection, remaining);
+}
+
+inline void getExpandedMembersByService(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::shared_ptr<ExpandedCollection>& collection,
+    std::vector<ExpandedMemberService>&& found, const std::string& service,
+    const std::string& subtree)
+{
+    // Services implement ObjectManager either at the root of the tree they
+    // populate, or at /
+    sdbusplus::message::object_path objectManagerPath(subtree);
+    dbus::utility::getManagedObjects(
+        service, objectManagerPath,
+        [asyncResp, collection, found{std::move(found)},
+         service](const boost::system::error_code& ec,
+                  const dbus::utility::ManagedObjectType& objects) mutable {
+        if (!ec)
+        {
+            afterGetExpandedManagedObjects(asyncResp, collection, found,
+                                           objects);
+            return;
+        }
+        dbus::utility::getManagedObjects(
+            service, sdbusplus::message::object_path("/"),
+            [asyncResp, collection, found{std::move(found)}](
+                const boost::system::error_code& ec2,
+                const dbus::utility::ManagedObjectType& objects2) {
+            if (ec2)
+            {
+                BMCWEB_LOG_DEBUG("No ObjectManager found, {}", ec2);
+                getExpandedMembersProperties(asyncResp, collection, found);
+                return;
+            }
+            afterGetExpandedManagedObjects(asyncResp, collection, found,
+                                           objects2);
+        });
+    });
+}
+
+inline void afterGetExpandedSubTree(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const boost::urls::url& collectionPath, const std::string& subtree,
+    const std::shared_ptr<ExpandedCollection>& collection,
+    const boost::system::error_code& ec,
+    const dbus::utility::MapperGetSubTreeResponse& objects)
+{
+    if (ec == boost::system::errc::io_error)
+    {
+        asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
+        asyncResp->res.jsonValue["Members@odata.count"] = 0;
+        return;
+    }
+
+    if (ec)
+    {
+        BMCWEB_LOG_DEBUG("DBUS response error {}", ec.value());
+        messages::internalError(asyncResp->res);
+        return;
+    }
+
+    std::vector<ExpandedMember>& members = collection->members;
+    for (const auto& [path, serviceMap] : objects)
+    {
+        std::string leaf = sdbusplus::message::object_path(path).filename();
+        if (leaf.empty() || serviceMap.empty())
+        {
+            continue;
+        }
+        members.push_back({std::move(leaf), path, serviceMap});
+    }
+    std::ranges::sort(members, AlphanumLess<std::string>(),
+                      &ExpandedMember::id);
+    collection->objects.resize(members.size());
+
+    // Start out with references, so that members that fail to fill in still
+    // show up
+    nlohmann::json::array_t memberArray;
+    boost::container::flat_map<std::string, std::vector<ExpandedMemberService>>
+        byService;
+    for (size_t index = 0; index < members.size(); index++)
+    {
+        const ExpandedMember& member = members[index];
+        boost::urls::url url = collectionPath;
+        crow::utility::appendUrlPieces(url, member.id);
+        nlohmann::json::object_t reference;
+        reference["@odata.id"] = std::move(url);
+        memberArray.emplace_back(std::move(reference));
+
+        ExpandedMemberObjects& memberObjects = collection->objects[index];
+        memberObjects.interfaces.resize(member.services.size());
+        memberObjects.outstanding = member.services.size();
+        for (size_t slot = 0; slot < member.services.size(); slot++)
+        {
+            byService[member.services[slot].first].push_back({index, slot});
+        }
+    }
+    asyncResp->res.jsonValue["Members@odata.count"] = memberArray.size();
+    asyncResp->res.jsonValue["Members"] = std::move(memberArray);
+
+    for (auto& [service, found] : byService)
+    {
+        getExpandedMembersByService(asyncResp, collection, std::move(found),
+                                    service, subtree);
+    }
+}
+
+/**
+ * @brief Populate the collection members with the members themselves, for
+ *        $expand, rather than references to them.  Every member comes from a
+ *        single GetManagedObjects call to each service that provides members,
+ *        so the number of D-Bus calls doesn't grow with the size of the
+ *        collection.
+ *
+ * @param[i,o] asyncResp  Async response object
+ * @param[in]  collectionPath  Redfish collection path which is used for the
+ *             Members Redfish Path
+ * @param[in]  interfaces  List of interfaces to constrain the GetSubTree search
+ * @param[in]  subtree     D-Bus base path to constrain search to.
+ * @param[in]  filler      Fills in each member, once all of its services have
+ *             answered
+ *
+ * @return void
+ */
+inline void getCollectionMembersExpanded(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const boost::urls::url& collectionPath,
+    std::span<const std::string_view> interfaces, const std::string& subtree,
+    ExpandedMemberFiller&& filler)
+{
+    BMCWEB_LOG_DEBUG("Get expanded collection members for: {}",
+                     collectionPath.buffer());
+    auto collection = std::make_shared<ExpandedCollection>();
+    collection->filler = std::move(filler);
+    dbus::utility::getSubTree(
+        subtree, 0, interfaces,
+        std::bind_front(afterGetExpandedSubTree, asyncResp, collectionPath,
+                        subtree, collection));
+}
+
 } // namespace collection_util
 } // namespace redfish
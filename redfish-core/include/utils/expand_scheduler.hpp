@@ -0,0 +1,103 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace redfish
+{
+namespace query_param
+{
+
+struct ExpandSchedulerStats
+{
+    size_t running = 0;
+    size_t queued = 0;
+    // Most subrequests that were waiting at once
+    size_t maxQueued = 0;
+};
+
+// Runs $expand subrequests a bounded number at a time, shared between every
+// request being expanded, so that expanding a large tree doesn't put hundreds
+// of calls on D-Bus at once.  Subrequests at shallower levels run first, then
+// in the order they were found.  Only used from the main io_context.
+class ExpandScheduler
+{
+  public:
+    // 0 runs every subrequest as soon as it's scheduled
+    explicit ExpandScheduler(size_t widthIn) : width(widthIn) {}
+
+    static ExpandScheduler& getInstance()
+    {
+        static ExpandScheduler scheduler{
+            static_cast<size_t>(BMCWEB_EXPAND_CONCURRENCY)};
+        return scheduler;
+    }
+
+    // Calls start once a slot is free.  Whatever start begins needs to call
+    // done() once it has finished, to hand its slot on.
+    void schedule(size_t depth, std::function<void()>&& start)
+    {
+        tasks.emplace(std::make_pair(depth, sequence++), std::move(start));
+        stats.queued = tasks.size();
+        if (stats.queued > stats.maxQueued)
+        {
+            stats.maxQueued = stats.queued;
+        }
+        runQueued();
+    }
+
+    void done()
+    {
+        if (stats.running == 0)
+        {
+            BMCWEB_LOG_ERROR("Expand subrequest finished without running");
+            return;
+        }
+        stats.running--;
+        runQueued();
+    }
+
+    const ExpandSchedulerStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    void runQueued()
+    {
+        // A subrequest that finishes straight away calls done() from inside
+        // start(), and the loop below picks up the slot it hands back
+        if (dispatching)
+        {
+            return;
+        }
+        dispatching = true;
+        while (!tasks.empty() && (width == 0 || stats.running < width))
+        {
+            auto it = tasks.begin();
+            std::function<void()> start = std::move(it->second);
+            tasks.erase(it);
+            stats.queued = tasks.size();
+            stats.running++;
+            start();
+        }
+        dispatching = false;
+    }
+
+    size_t width;
+    // Keyed on depth, then the order subrequests were scheduled in
+    std::map<std::pair<size_t, uint64_t>, std::function<void()>> tasks;
+    uint64_t sequence = 0;
+    bool dispatching = false;
+    ExpandSchedulerStats stats;
+};
+
+} // namespace query_param
+} // namespace redfish
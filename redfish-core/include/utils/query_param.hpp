@@ -11,6 +11,7 @@
 #include "json_formatters.hpp"
 #include "logging.hpp"
 #include "str_utility.hpp"
+#include "utils/expand_scheduler.hpp"
 
 #include <sys/types.h>
 
@@ -26,7 +27,9 @@
 #include <charconv>
 #include <compare>
 #include <cstdint>
+#include <format>
 #include <functional>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -66,7 +69,7 @@ class SelectTrieNode
   public:
     SelectTrieNode() = default;
 
-    const SelectTrieNode* find(const std::string& jsonKey) const
+    const SelectTrieNode* find(std::string_view jsonKey) const
     {
         auto it = children.find(jsonKey);
         if (it == children.end())
@@ -163,6 +166,43 @@ struct SelectTrie
         return true;
     }
 
+    // Whether any of nestedProperty, written the same way as a $select value,
+    // is kept when $select is applied.  Lets handlers skip reading properties
+    // that would only be removed again.  Everything is kept when there's no
+    // $select.
+    bool isSelected(std::string_view nestedProperty) const
+    {
+        if (root.empty())
+        {
+            return true;
+        }
+        const SelectTrieNode* currNode = &root;
+        while (!nestedProperty.empty())
+        {
+            size_t index = nestedProperty.find_first_of('/');
+            currNode = currNode->find(nestedProperty.substr(0, index));
+            if (currNode == nullptr)
+            {
+                return false;
+            }
+            if (currNode->isSelected() || index == std::string_view::npos)
+            {
+                return true;
+            }
+            nestedProperty.remove_prefix(index + 1);
+        }
+        return true;
+    }
+
+    bool isSelected(
+        std::initializer_list<std::string_view> nestedProperties) const
+    {
+        return std::ranges::any_of(nestedProperties,
+                                   [this](std::string_view nestedProperty) {
+            return isSelected(nestedProperty);
+        });
+    }
+
     SelectTrieNode root;
 };
 
@@ -203,6 +243,13 @@ struct QueryCapabilities
     bool canDelegateSkip = false;
     uint8_t canDelegateExpandLevel = 0;
     bool canDelegateSelect = false;
+    // The handler skips reading properties that $select leaves out, going by
+    // SelectTrie::isSelected(), but leaves removing the rest to the default
+    // processing
+    bool canSkipUnselected = false;
+    // The handler evaluates $filter against each member itself, before
+    // applying any delegated $top and $skip to the members that match
+    bool canDelegateFilter = false;
 };
 
 // Delegates query parameters according to the given |queryCapabilities|
@@ -235,15 +282,26 @@ inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
         }
     }
 
+    // delegate filter
+    if (query.filter && queryCapabilities.canDelegateFilter)
+    {
+        delegated.filter = std::move(query.filter);
+        query.filter = std::nullopt;
+    }
+
+    // $top and $skip apply to the members that pass $filter, so they can
+    // only be delegated along with it
+    bool canPage = !query.filter;
+
     // delegate top
-    if (query.top && queryCapabilities.canDelegateTop)
+    if (query.top && queryCapabilities.canDelegateTop && canPage)
     {
         delegated.top = query.top;
         query.top = std::nullopt;
     }
 
     // delegate skip
-    if (query.skip && queryCapabilities.canDelegateSkip)
+    if (query.skip && queryCapabilities.canDelegateSkip && canPage)
     {
         delegated.skip = query.skip;
         query.skip = 0;
@@ -255,6 +313,10 @@ inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
         delegated.selectTrie = std::move(query.selectTrie);
         query.selectTrie.root.clear();
     }
+    else if (queryCapabilities.canSkipUnselected)
+    {
+        delegated.selectTrie = query.selectTrie;
+    }
     return delegated;
 }
 
@@ -710,6 +772,29 @@ inline std::vector<ExpandNode>
     return ret;
 }
 
+// Counts the expanded resources between |root| and the link at |location|,
+// not counting |root| itself
+inline int countExpandedAbove(const nlohmann::json& root,
+                              nlohmann::json::json_pointer location)
+{
+    int count = 0;
+    while (!location.empty())
+    {
+        location.pop_back();
+        if (location.empty())
+        {
+            break;
+        }
+        const nlohmann::json& parent = root[location];
+        if (parent.is_object() && parent.size() > 1 &&
+            parent.contains("@odata.id"))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
 // Formats a query parameter string for the sub-query.
 // Returns std::nullopt on failures.
 // This function shall handle $select when it is added.
@@ -830,82 +915,166 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
     // allows callers to attach sub-responses within the json tree that need
     // to be executed and filled into their appropriate locations.  This
     // class manages the final "merge" of the json resources.
+    //
+    // Every level of the expansion is driven from here.  Subrequests go
+    // through the ExpandScheduler, and each response is searched for the
+    // next level's links as it's merged in.  Subrequests ask for the levels
+    // that are left, so handlers that expand their members themselves still
+    // do so, but expand nothing beyond that.
     MultiAsyncResp(crow::App& appIn,
                    std::shared_ptr<bmcweb::AsyncResp> finalResIn) :
         app(appIn),
         finalRes(std::move(finalResIn))
     {}
 
-    void addAwaitingResponse(
-        const std::shared_ptr<bmcweb::AsyncResp>& res,
-        const nlohmann::json::json_pointer& finalExpandLocation)
+    MultiAsyncResp(const MultiAsyncResp&) = delete;
+    MultiAsyncResp(MultiAsyncResp&&) = delete;
+    MultiAsyncResp& operator=(const MultiAsyncResp&) = delete;
+    MultiAsyncResp& operator=(MultiAsyncResp&&) = delete;
+
+    // Runs once every subrequest has been placed, just before the response
+    // is sent
+    ~MultiAsyncResp()
     {
-        res->res.setCompleteRequestHandler(std::bind_front(
-            placeResultStatic, shared_from_this(), finalExpandLocation));
+        if (unexpanded == 0)
+        {
+            return;
+        }
+        // The response is still a 200, so say that it isn't complete
+        nlohmann::json& extendedInfo =
+            finalRes->res.jsonValue[messages::messageAnnotation];
+        if (!extendedInfo.is_array())
+        {
+            extendedInfo = nlohmann::json::array();
+        }
+        extendedInfo.push_back(messages::queryParameterOutOfRange(
+            std::to_string(expandLevel), "$levels",
+            std::format("the {} subrequest budget; {} links were left "
+                        "unexpanded",
+                        BMCWEB_EXPAND_WORK_BUDGET, unexpanded)));
     }
 
     void placeResult(const nlohmann::json::json_pointer& locationToPlace,
-                     crow::Response& res)
+                     size_t depth, int levels, crow::Response& res)
     {
         BMCWEB_LOG_DEBUG("placeResult for {}", locationToPlace);
         propogateError(finalRes->res, res);
-        if (!res.jsonValue.is_object() || res.jsonValue.empty())
+        if (res.jsonValue.is_object() && !res.jsonValue.empty())
         {
-            return;
+            nlohmann::json& finalObj = finalRes->res.jsonValue[locationToPlace];
+            finalObj = std::move(res.jsonValue);
+            if (levels > 0)
+            {
+                for (ExpandNode& node : findNavigationReferences(
+                         expandType, levels, 0, finalObj))
+                {
+                    // Links within members the handler expanded are that
+                    // many levels further down
+                    int expanded = countExpandedAbove(finalObj, node.location);
+                    node.location = locationToPlace / node.location;
+                    schedule(std::move(node),
+                             depth + 1 + static_cast<size_t>(expanded),
+                             levels - 1 - expanded);
+                }
+            }
         }
-        nlohmann::json& finalObj = finalRes->res.jsonValue[locationToPlace];
-        finalObj = std::move(res.jsonValue);
+        ExpandScheduler::getInstance().done();
     }
 
-    // Handles the very first level of Expand, and starts a chain of sub-queries
-    // for deeper levels.
+    // Handles the very first level of Expand, and schedules the subrequests
+    // for it.  Deeper levels are scheduled as their parents come back.
     void startQuery(const Query& query, const Query& delegated)
     {
+        expandType = query.expandType;
+        expandLevel = query.expandLevel;
         std::vector<ExpandNode> nodes = findNavigationReferences(
             query.expandType, query.expandLevel, delegated.expandLevel,
             finalRes->res.jsonValue);
         BMCWEB_LOG_DEBUG("{} nodes to traverse", nodes.size());
-        const std::optional<std::string> queryStr = formatQueryForExpand(query);
+        for (ExpandNode& node : nodes)
+        {
+            schedule(std::move(node), 1, query.expandLevel - 1);
+        }
+    }
+
+  private:
+    // levels is how many levels below node are still to be expanded
+    void schedule(ExpandNode&& node, size_t depth, int levels)
+    {
+        if (BMCWEB_EXPAND_WORK_BUDGET != 0 &&
+            scheduled >= static_cast<size_t>(BMCWEB_EXPAND_WORK_BUDGET))
+        {
+            leaveUnexpanded(node);
+            return;
+        }
+        scheduled++;
+        ExpandScheduler::getInstance().schedule(
+            depth, [self{shared_from_this()}, node{std::move(node)}, depth,
+                    levels]() { self->startSubquery(node, depth, levels); });
+    }
+
+    void startSubquery(const ExpandNode& node, size_t depth, int levels)
+    {
+        Query rest{.expandLevel = static_cast<uint8_t>(levels + 1),
+                   .expandType = expandType};
+        std::optional<std::string> queryStr = formatQueryForExpand(rest);
         if (!queryStr)
         {
             messages::internalError(finalRes->res);
+            ExpandScheduler::getInstance().done();
             return;
         }
-        for (const ExpandNode& node : nodes)
+        std::string uri = node.uri + *queryStr;
+        BMCWEB_LOG_DEBUG("URL of subquery:  {}", uri);
+        std::error_code ec;
+        auto newReq = std::make_shared<crow::Request>(
+            crow::Request::Body{boost::beast::http::verb::get, uri, 11}, ec);
+        if (ec)
         {
-            const std::string subQuery = node.uri + *queryStr;
-            BMCWEB_LOG_DEBUG("URL of subquery:  {}", subQuery);
-            std::error_code ec;
-            auto newReq = std::make_shared<crow::Request>(
-                crow::Request::Body{boost::beast::http::verb::get, subQuery,
-                                    11},
-                ec);
-            if (ec)
-            {
-                messages::internalError(finalRes->res);
-                return;
-            }
+            messages::internalError(finalRes->res);
+            ExpandScheduler::getInstance().done();
+            return;
+        }
+        newReq->expandSubrequest = true;
 
-            auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
-            BMCWEB_LOG_DEBUG("setting completion handler on {}",
-                             logPtr(&asyncResp->res));
+        auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+        BMCWEB_LOG_DEBUG("setting completion handler on {}",
+                         logPtr(&asyncResp->res));
+        asyncResp->res.setCompleteRequestHandler(
+            std::bind_front(placeResultStatic, shared_from_this(),
+                            node.location, depth, levels));
+        app.handle(newReq, asyncResp);
+    }
 
-            addAwaitingResponse(asyncResp, node.location);
-            app.handle(newReq, asyncResp);
+    // The work budget is spent, so the link is left as it is.  The response
+    // says how many were left once it's complete.
+    void leaveUnexpanded(const ExpandNode& node)
+    {
+        if (unexpanded == 0)
+        {
+            BMCWEB_LOG_WARNING(
+                "$expand made {} subrequests, leaving the rest unexpanded",
+                scheduled);
         }
+        unexpanded++;
+        BMCWEB_LOG_DEBUG("Leaving {} unexpanded", node.uri);
     }
 
-  private:
     static void
         placeResultStatic(const std::shared_ptr<MultiAsyncResp>& multi,
                           const nlohmann::json::json_pointer& locationToPlace,
-                          crow::Response& res)
+                          size_t depth, int levels, crow::Response& res)
     {
-        multi->placeResult(locationToPlace, res);
+        multi->placeResult(locationToPlace, depth, levels, res);
     }
 
     crow::App& app;
     std::shared_ptr<bmcweb::AsyncResp> finalRes;
+    ExpandType expandType = ExpandType::None;
+    uint8_t expandLevel = 0;
+    // Subrequests made so far, against BMCWEB_EXPAND_WORK_BUDGET
+    size_t scheduled = 0;
+    size_t unexpanded = 0;
 };
 
 inline void processTopAndSkip(const Query& query, crow::Response& res)
@@ -1051,6 +1220,12 @@ inline void
         return;
     }
 
+    // Members are filtered before they're paged through
+    if (query.filter && query.expandType == ExpandType::None)
+    {
+        applyFilter(intermediateResponse.jsonValue, *query.filter);
+    }
+
     if (query.top || query.skip)
     {
         processTopAndSkip(query, intermediateResponse);
@@ -1068,11 +1243,6 @@ inline void
         return;
     }
 
-    if (query.filter)
-    {
-        applyFilter(intermediateResponse.jsonValue, *query.filter);
-    }
-
     // According to Redfish Spec Section 7.3.1, $select is the last parameter to
     // to process
     if (!query.selectTrie.root.empty())
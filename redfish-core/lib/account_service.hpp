@@ -23,6 +23,7 @@
 #include "persistent_data.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
+#include "user_info_cache.hpp"
 #include "utils/collection.hpp"
 #include "utils/dbus_utils.hpp"
 #include "utils/json_utils.hpp"
@@ -1118,6 +1119,9 @@ inline void updateUserProperties(
                 // Remove existing sessions of the user when password changed
                 persistent_data::SessionStore::getInstance()
                     .removeSessionsByUsernameExceptSession(username, session);
+                // Setting the password clears UserPasswordExpired, which
+                // isn't signalled
+                bmcweb::UserInfoCache::getInstance().invalidate();
                 messages::success(asyncResp->res);
             }
         }
@@ -1644,6 +1648,7 @@ inline void processAfterCreateUser(
         BMCWEB_LOG_ERROR("pamUpdatePassword Failed");
         return;
     }
+    bmcweb::UserInfoCache::getInstance().invalidate();
 
     messages::created(asyncResp->res);
     asyncResp->res.addHeader("Location",
@@ -22,6 +22,7 @@
 #include "human_sort.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
+#include "utils/collection.hpp"
 #include "utils/ip_utils.hpp"
 #include "utils/json_utils.hpp"
 
@@ -1107,6 +1108,43 @@ inline void handleIPv6DefaultGateway(
     }
 }
 
+/**
+ * Function that extracts all properties of the given Ethernet Interface from
+ * the objects the Network Manager provides
+ * @param ethifaceId a eth interface id to extract
+ * @param resp the result of GetManagedObjects on the Network Manager
+ * @return true if the interface exists and its data could be extracted
+ */
+inline bool
+    extractEthernetIfaceData(const std::string& ethifaceId,
+                             const dbus::utility::ManagedObjectType& resp,
+                             EthernetInterfaceData& ethData,
+                             std::vector<IPv4AddressData>& ipv4Data,
+                             std::vector<IPv6AddressData>& ipv6Data,
+                             std::vector<StaticGatewayData>& ipv6GatewayData)
+{
+    bool found = extractEthernetInterfaceData(ethifaceId, resp, ethData);
+    if (!found)
+    {
+        return false;
+    }
+
+    extractIPData(ethifaceId, resp, ipv4Data);
+    // Fix global GW
+    for (IPv4AddressData& ipv4 : ipv4Data)
+    {
+        if (((ipv4.linktype == LinkType::Global) &&
+             (ipv4.gateway == "0.0.0.0")) ||
+            (ipv4.origin == "DHCP") || (ipv4.origin == "Static"))
+        {
+            ipv4.gateway = ethData.defaultGateway;
+        }
+    }
+
+    extractIPV6Data(ethifaceId, resp, ipv6Data);
+    return extractIPv6DefaultGatewayData(ethifaceId, resp, ipv6GatewayData);
+}
+
 /**
  * Function that retrieves all properties for given Ethernet Interface
  * Object
@@ -1137,33 +1175,49 @@ void getEthernetIfaceData(const std::string& ethifaceId,
             return;
         }
 
-        bool found = extractEthernetInterfaceData(ethifaceId, resp, ethData);
-        if (!found)
-        {
-            callback(false, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
-            return;
-        }
+        bool success = extractEthernetIfaceData(ethifaceId, resp, ethData,
+                                                ipv4Data, ipv6Data,
+                                                ipv6GatewayData);
+        // Finally make a callback with useful data
+        callback(success, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
+    });
+}
 
-        extractIPData(ethifaceId, resp, ipv4Data);
-        // Fix global GW
-        for (IPv4AddressData& ipv4 : ipv4Data)
+/**
+ * Function that lists the Ethernet Interfaces among the objects the Network
+ * Manager provides, in the order they're shown in the collection
+ */
+inline std::vector<std::string>
+    extractEthernetIfaceList(const dbus::utility::ManagedObjectType& resp)
+{
+    std::vector<std::string> ifaceList;
+    ifaceList.reserve(resp.size());
+
+    // Iterate over all retrieved ObjectPaths.
+    for (const auto& objpath : resp)
+    {
+        // And all interfaces available for certain ObjectPath.
+        for (const auto& interface : objpath.second)
         {
-            if (((ipv4.linktype == LinkType::Global) &&
-                 (ipv4.gateway == "0.0.0.0")) ||
-                (ipv4.origin == "DHCP") || (ipv4.origin == "Static"))
+            // If interface is
+            // xyz.openbmc_project.Network.EthernetInterface, this is
+            // what we're looking for.
+            if (interface.first ==
+                "xyz.openbmc_project.Network.EthernetInterface")
             {
-                ipv4.gateway = ethData.defaultGateway;
+                std::string ifaceId = objpath.first.filename();
+                if (ifaceId.empty())
+                {
+                    continue;
+                }
+                // and put it into output vector.
+                ifaceList.emplace_back(ifaceId);
             }
         }
+    }
 
-        extractIPV6Data(ethifaceId, resp, ipv6Data);
-        if (!extractIPv6DefaultGatewayData(ethifaceId, resp, ipv6GatewayData))
-        {
-            callback(false, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
-        }
-        // Finally make a callback with useful data
-        callback(true, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
-    });
+    std::ranges::sort(ifaceList, AlphanumLess<std::string>());
+    return ifaceList;
 }
 
 /**
@@ -1183,38 +1237,13 @@ void getEthernetIfaceList(CallbackFunc&& callback)
             const dbus::utility::ManagedObjectType& resp) {
         // Callback requires vector<string> to retrieve all available
         // ethernet interfaces
-        std::vector<std::string> ifaceList;
-        ifaceList.reserve(resp.size());
         if (ec)
         {
-            callback(false, ifaceList);
+            callback(false, std::vector<std::string>());
             return;
         }
 
-        // Iterate over all retrieved ObjectPaths.
-        for (const auto& objpath : resp)
-        {
-            // And all interfaces available for certain ObjectPath.
-            for (const auto& interface : objpath.second)
-            {
-                // If interface is
-                // xyz.openbmc_project.Network.EthernetInterface, this is
-                // what we're looking for.
-                if (interface.first ==
-                    "xyz.openbmc_project.Network.EthernetInterface")
-                {
-                    std::string ifaceId = objpath.first.filename();
-                    if (ifaceId.empty())
-                    {
-                        continue;
-                    }
-                    // and put it into output vector.
-                    ifaceList.emplace_back(ifaceId);
-                }
-            }
-        }
-
-        std::ranges::sort(ifaceList, AlphanumLess<std::string>());
+        std::vector<std::string> ifaceList = extractEthernetIfaceList(resp);
 
         // Finally make a callback with useful data
         callback(true, ifaceList);
@@ -1983,6 +2012,78 @@ inline void
     }
 }
 
+inline void fillEthernetInterface(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::string& ifaceId, const EthernetInterfaceData& ethData,
+    const std::vector<IPv4AddressData>& ipv4Data,
+    const std::vector<IPv6AddressData>& ipv6Data,
+    const std::vector<StaticGatewayData>& ipv6GatewayData)
+{
+    asyncResp->res.jsonValue["@odata.type"] =
+        "#EthernetInterface.v1_9_0.EthernetInterface";
+    asyncResp->res.jsonValue["Name"] = "Manager Ethernet Interface";
+    asyncResp->res.jsonValue["Description"] = "Management Network Interface";
+
+    parseInterfaceData(asyncResp, ifaceId, ethData, ipv4Data, ipv6Data,
+                       ipv6GatewayData);
+}
+
+/**
+ * Function that fills in the EthernetInterfaces collection with the
+ * interfaces themselves, for $expand.  Every interface comes from the same
+ * GetManagedObjects call that lists them.
+ */
+inline void getEthernetIfacesExpanded(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    sdbusplus::message::object_path path("/xyz/openbmc_project/network");
+    dbus::utility::getManagedObjects(
+        "xyz.openbmc_project.Network", path,
+        [asyncResp](const boost::system::error_code& ec,
+                    const dbus::utility::ManagedObjectType& resp) {
+        if (ec)
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+
+        std::vector<std::string> ifaceList = extractEthernetIfaceList(resp);
+
+        // Start out with references, so that interfaces that fail to fill in
+        // still show up
+        nlohmann::json::array_t ifaceArray;
+        for (const std::string& ifaceItem : ifaceList)
+        {
+            nlohmann::json::object_t iface;
+            iface["@odata.id"] = boost::urls::format(
+                "/redfish/v1/Managers/{}/EthernetInterfaces/{}",
+                BMCWEB_REDFISH_MANAGER_URI_NAME, ifaceItem);
+            ifaceArray.emplace_back(std::move(iface));
+        }
+        asyncResp->res.jsonValue["Members@odata.count"] = ifaceArray.size();
+        asyncResp->res.jsonValue["Members"] = std::move(ifaceArray);
+
+        for (size_t index = 0; index < ifaceList.size(); index++)
+        {
+            const std::string& ifaceId = ifaceList[index];
+            EthernetInterfaceData ethData{};
+            std::vector<IPv4AddressData> ipv4Data;
+            std::vector<IPv6AddressData> ipv6Data;
+            std::vector<StaticGatewayData> ipv6GatewayData;
+            if (!extractEthernetIfaceData(ifaceId, resp, ethData, ipv4Data,
+                                          ipv6Data, ipv6GatewayData))
+            {
+                BMCWEB_LOG_ERROR("Couldn't extract data for interface {}",
+                                 ifaceId);
+                continue;
+            }
+            fillEthernetInterface(
+                collection_util::makeExpandedMemberResp(asyncResp, index),
+                ifaceId, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
+        }
+    });
+}
+
 inline void afterDelete(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                         const std::string& ifaceId,
                         const boost::system::error_code& ec,
@@ -2069,7 +2170,12 @@ inline void requestEthernetInterfacesRoutes(App& app)
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                    const std::string& managerId) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateExpandLevel = 1,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -2090,6 +2196,12 @@ inline void requestEthernetInterfacesRoutes(App& app)
         asyncResp->res.jsonValue["Description"] =
             "Collection of EthernetInterfaces for this Manager";
 
+        if (collection_util::expandsMembers(delegatedQuery))
+        {
+            getEthernetIfacesExpanded(asyncResp);
+            return;
+        }
+
         // Get eth interface list, and call the below callback for JSON
         // preparation
         getEthernetIfaceList(
@@ -2243,14 +2355,8 @@ inline void requestEthernetInterfacesRoutes(App& app)
                 return;
             }
 
-            asyncResp->res.jsonValue["@odata.type"] =
-                "#EthernetInterface.v1_9_0.EthernetInterface";
-            asyncResp->res.jsonValue["Name"] = "Manager Ethernet Interface";
-            asyncResp->res.jsonValue["Description"] =
-                "Management Network Interface";
-
-            parseInterfaceData(asyncResp, ifaceId, ethData, ipv4Data, ipv6Data,
-                               ipv6GatewayData);
+            fillEthernetInterface(asyncResp, ifaceId, ethData, ipv4Data,
+                                  ipv6Data, ipv6GatewayData);
         });
     });
 
@@ -18,6 +18,8 @@
 #include "app.hpp"
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
+#include "event_log_index.hpp"
+#include "filter_expr_executor.hpp"
 #include "generated/enums/log_entry.hpp"
 #include "gzfile.hpp"
 #include "http_utility.hpp"
@@ -32,6 +34,7 @@
 #include "utils/dbus_utils.hpp"
 #include "utils/json_utils.hpp"
 #include "utils/time_utils.hpp"
+#include "worker_pool.hpp"
 
 #include <systemd/sd-id128.h>
 #include <systemd/sd-journal.h>
@@ -50,9 +53,12 @@
 
 #include <array>
 #include <charconv>
+#include <cstdlib>
 #include <cstddef>
 #include <filesystem>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -204,9 +210,11 @@ inline bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
                              const bool firstEntry = true)
 {
     int ret = 0;
-    static sd_id128_t prevBootID{};
-    static uint64_t prevTs = 0;
-    static int index = 0;
+    // The journal may be walked on a worker thread, so each thread keeps its
+    // own state
+    thread_local sd_id128_t prevBootID{};
+    thread_local uint64_t prevTs = 0;
+    thread_local int index = 0;
     if (firstEntry)
     {
         prevBootID = {};
@@ -253,45 +261,6 @@ inline bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
     return true;
 }
 
-static bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
-                             const bool firstEntry = true)
-{
-    static time_t prevTs = 0;
-    static int index = 0;
-    if (firstEntry)
-    {
-        prevTs = 0;
-    }
-
-    // Get the entry timestamp
-    std::time_t curTs = 0;
-    std::tm timeStruct = {};
-    std::istringstream entryStream(logEntry);
-    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
-    {
-        curTs = std::mktime(&timeStruct);
-    }
-    // If the timestamp isn't unique, increment the index
-    if (curTs == prevTs)
-    {
-        index++;
-    }
-    else
-    {
-        // Otherwise, reset it
-        index = 0;
-    }
-    // Save the timestamp
-    prevTs = curTs;
-
-    entryID = std::to_string(curTs);
-    if (index > 0)
-    {
-        entryID += "_" + std::to_string(index);
-    }
-    return true;
-}
-
 // Entry is formed like "BootID_timestamp" or "BootID_timestamp_index"
 inline bool
     getTimestampFromID(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -1482,6 +1451,7 @@ inline void requestRoutesJournalEventLogClear(App& app)
                 std::filesystem::remove(file, ec);
             }
         }
+        EventLogIndex::getInstance().changed();
 
         // Reload rsyslog so it knows to start new log files
         crow::connections::systemBus->async_method_call(
@@ -1507,10 +1477,17 @@ enum class LogParseError
     messageIdNotInRegistry,
 };
 
-static LogParseError
-    fillEventLogEntryJson(const std::string& logEntryID,
-                          const std::string& logEntry,
-                          nlohmann::json::object_t& logEntryJson)
+// A line of the Redfish event log, split into its fields
+struct EventLogRecord
+{
+    std::string timestamp;
+    // The MessageId, followed by the MessageArgs
+    std::vector<std::string> fields;
+    const registries::Message* message = nullptr;
+};
+
+static LogParseError parseEventLogEntry(const std::string& logEntry,
+                                        EventLogRecord& record)
 {
     // The redfish log format is "<Timestamp> <MessageId>,<MessageArgs>"
     // First get the Timestamp
@@ -1519,7 +1496,7 @@ static LogParseError
     {
         return LogParseError::parseFailed;
     }
-    std::string timestamp = logEntry.substr(0, space);
+    record.timestamp = logEntry.substr(0, space);
     // Then get the log contents
     size_t entryStart = logEntry.find_first_not_of(' ', space);
     if (entryStart == std::string::npos)
@@ -1529,44 +1506,46 @@ static LogParseError
     std::string_view entry(logEntry);
     entry.remove_prefix(entryStart);
     // Use split to separate the entry into its fields
-    std::vector<std::string> logEntryFields;
-    bmcweb::split(logEntryFields, entry, ',');
+    bmcweb::split(record.fields, entry, ',');
     // We need at least a MessageId to be valid
-    auto logEntryIter = logEntryFields.begin();
-    if (logEntryIter == logEntryFields.end())
+    if (record.fields.empty())
     {
         return LogParseError::parseFailed;
     }
-    std::string& messageID = *logEntryIter;
     // Get the Message from the MessageRegistry
-    const registries::Message* message = registries::getMessage(messageID);
-
-    logEntryIter++;
-    if (message == nullptr)
+    record.message = registries::getMessage(record.fields.front());
+    if (record.message == nullptr)
     {
         BMCWEB_LOG_WARNING("Log entry not found in registry: {}", logEntry);
         return LogParseError::messageIdNotInRegistry;
     }
 
-    std::vector<std::string_view> messageArgs(logEntryIter,
-                                              logEntryFields.end());
-    messageArgs.resize(message->numberOfArgs);
-
-    std::string msg = redfish::registries::fillMessageArgs(messageArgs,
-                                                           message->message);
-    if (msg.empty())
-    {
-        return LogParseError::parseFailed;
-    }
-
     // Get the Created time from the timestamp. The log timestamp is in RFC3339
     // format which matches the Redfish format except for the fractional seconds
     // between the '.' and the '+', so just remove them.
-    std::size_t dot = timestamp.find_first_of('.');
-    std::size_t plus = timestamp.find_first_of('+');
+    std::size_t dot = record.timestamp.find_first_of('.');
+    std::size_t plus = record.timestamp.find_first_of('+');
     if (dot != std::string::npos && plus != std::string::npos)
     {
-        timestamp.erase(dot, plus - dot);
+        record.timestamp.erase(dot, plus - dot);
+    }
+    return LogParseError::success;
+}
+
+static LogParseError
+    fillEventLogEntryJson(const std::string& logEntryID,
+                          const EventLogRecord& record,
+                          nlohmann::json::object_t& logEntryJson)
+{
+    std::vector<std::string_view> messageArgs(record.fields.begin() + 1,
+                                              record.fields.end());
+    messageArgs.resize(record.message->numberOfArgs);
+
+    std::string msg = redfish::registries::fillMessageArgs(
+        messageArgs, record.message->message);
+    if (msg.empty())
+    {
+        return LogParseError::parseFailed;
     }
 
     // Fill in the log entry with the gathered data
@@ -1577,14 +1556,96 @@ static LogParseError
     logEntryJson["Name"] = "System Event Log Entry";
     logEntryJson["Id"] = logEntryID;
     logEntryJson["Message"] = std::move(msg);
-    logEntryJson["MessageId"] = std::move(messageID);
+    logEntryJson["MessageId"] = record.fields.front();
     logEntryJson["MessageArgs"] = messageArgs;
     logEntryJson["EntryType"] = "Event";
-    logEntryJson["Severity"] = message->messageSeverity;
-    logEntryJson["Created"] = std::move(timestamp);
+    logEntryJson["Severity"] = record.message->messageSeverity;
+    logEntryJson["Created"] = record.timestamp;
     return LogParseError::success;
 }
 
+static LogParseError
+    fillEventLogEntryJson(const std::string& logEntryID,
+                          const std::string& logEntry,
+                          nlohmann::json::object_t& logEntryJson)
+{
+    EventLogRecord record;
+    LogParseError status = parseEventLogEntry(logEntry, record);
+    if (status != LogParseError::success)
+    {
+        return status;
+    }
+    return fillEventLogEntryJson(logEntryID, record, logEntryJson);
+}
+
+// Evaluates a delegated $filter against an event log entry.  The properties
+// that come straight from the log line are looked up without building the
+// rest of the entry.
+static bool eventLogEntryMatchesFilter(const std::string& logEntryID,
+                                       const EventLogRecord& record,
+                                       const CompiledFilter& filter)
+{
+    nlohmann::json::object_t properties;
+    bool filled = false;
+    auto lookup = [&](std::string_view property) -> const nlohmann::json* {
+        auto it = properties.find(property);
+        if (it != properties.end())
+        {
+            return &it->second;
+        }
+        nlohmann::json value;
+        if (property == "Id")
+        {
+            value = logEntryID;
+        }
+        else if (property == "MessageId")
+        {
+            value = record.fields.front();
+        }
+        else if (property == "Severity")
+        {
+            value = record.message->messageSeverity;
+        }
+        else if (property == "Created")
+        {
+            value = record.timestamp;
+        }
+        else if (property == "EntryType")
+        {
+            value = "Event";
+        }
+        else
+        {
+            if (filled)
+            {
+                return nullptr;
+            }
+            // Anything else, such as the Message, needs the whole entry.
+            // Values already handed out stay where they are.
+            filled = true;
+            nlohmann::json::object_t entry;
+            if (fillEventLogEntryJson(logEntryID, record, entry) !=
+                LogParseError::success)
+            {
+                return nullptr;
+            }
+            for (auto& [key, entryValue] : entry)
+            {
+                properties.emplace(key, std::move(entryValue));
+            }
+            it = properties.find(property);
+            if (it == properties.end())
+            {
+                return nullptr;
+            }
+            return &it->second;
+        }
+        return &properties.emplace(std::string(property), std::move(value))
+                    .first->second;
+    };
+    return filter.matches(lookup);
+}
+
 std::string severityToString(int level)
 {
     switch (level)
@@ -1696,6 +1757,7 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
         query_param::QueryCapabilities capabilities = {
             .canDelegateTop = true,
             .canDelegateSkip = true,
+            .canDelegateFilter = true,
         };
         query_param::Query delegatedQuery;
         if (!redfish::setUpRedfishRouteWithDelegation(
@@ -1733,66 +1795,92 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
 
         nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
         logEntryArray = nlohmann::json::array();
-        // Go through the log files and create a unique ID for each
-        // entry
-        std::vector<std::filesystem::path> redfishLogFiles;
-        getRedfishLogFiles(redfishLogFiles);
-        uint64_t entryCount = 0;
-        std::string logEntry;
-
-        // Oldest logs are in the last file, so start there and loop
-        // backwards
-        for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend();
-             it++)
+        // Compiled once, rather than walked for every entry
+        std::optional<CompiledFilter> filter;
+        if (delegatedQuery.filter)
         {
-            std::ifstream logStream(*it);
-            if (!logStream.is_open())
-            {
-                continue;
-            }
-
-            // Reset the unique ID on the first entry
-            bool firstEntry = true;
-            while (std::getline(logStream, logEntry))
-            {
-                std::string idStr;
-                if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-                {
-                    continue;
-                }
-                firstEntry = false;
-
-                nlohmann::json::object_t bmcLogEntry;
-                LogParseError status = fillEventLogEntryJson(idStr, logEntry,
-                                                             bmcLogEntry);
-                if (status == LogParseError::messageIdNotInRegistry)
+            filter.emplace(*delegatedQuery.filter);
+        }
+        EventLogIndex& index = EventLogIndex::getInstance();
+        uint64_t entryCount = 0;
+        bool parsed = true;
+        bool read = false;
+        if (filter)
+        {
+            // Entries that don't pass the filter aren't counted, or built, so
+            // every entry needs to be looked at
+            read = index.readEntries(
+                0, index.size(),
+                [&](const std::string& idStr, const std::string& logEntry) {
+                EventLogRecord record;
+                LogParseError status = parseEventLogEntry(logEntry, record);
+                if (status != LogParseError::success)
                 {
-                    continue;
+                    parsed = false;
+                    return false;
                 }
-                if (status != LogParseError::success)
+                if (!eventLogEntryMatchesFilter(idStr, record, *filter))
                 {
-                    messages::internalError(asyncResp->res);
-                    return;
+                    return true;
                 }
-
                 entryCount++;
-                // Handle paging using skip (number of entries to skip from the
-                // start) and top (number of entries to display)
+                // Handle paging using skip (number of entries to skip from
+                // the start) and top (number of entries to display)
                 if (entryCount <= skip || entryCount > skip + top)
                 {
-                    continue;
+                    return true;
+                }
+                nlohmann::json::object_t bmcLogEntry;
+                if (fillEventLogEntryJson(idStr, record, bmcLogEntry) !=
+                    LogParseError::success)
+                {
+                    parsed = false;
+                    return false;
                 }
-
                 logEntryArray.emplace_back(std::move(bmcLogEntry));
-            }
+                return true;
+            });
+        }
+        else
+        {
+            // The index knows where the page starts, so only the entries on
+            // it are read
+            entryCount = index.size();
+            read = index.readEntries(
+                skip, top,
+                [&](const std::string& idStr, const std::string& logEntry) {
+                nlohmann::json::object_t bmcLogEntry;
+                if (fillEventLogEntryJson(idStr, logEntry, bmcLogEntry) !=
+                    LogParseError::success)
+                {
+                    parsed = false;
+                    return false;
+                }
+                logEntryArray.emplace_back(std::move(bmcLogEntry));
+                return true;
+            });
+        }
+        if (!read || !parsed)
+        {
+            messages::internalError(asyncResp->res);
+            return;
         }
         asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
         if (skip + top < entryCount)
         {
-            asyncResp->res
-                .jsonValue["Members@odata.nextLink"] = boost::urls::format(
-                "/redfish/v1/Systems/{}/LogServices/EventLog/Entries?$skip={}",
-                BMCWEB_REDFISH_SYSTEM_URI_NAME, std::to_string(skip + top));
+            boost::urls::url nextLink = boost::urls::format(
+                "/redfish/v1/Systems/{}/LogServices/EventLog/Entries",
+                BMCWEB_REDFISH_SYSTEM_URI_NAME);
+            nextLink.params().set("$skip", std::to_string(skip + top));
+            // The next page is of the same filtered entries
+            boost::urls::params_view params = req.url().params();
+            auto filterParam = params.find("$filter");
+            if (filterParam != params.end())
+            {
+                nextLink.params().set("$filter", (*filterParam).value);
+            }
+            asyncResp->res.jsonValue["Members@odata.nextLink"] =
+                std::move(nextLink);
         }
     });
 }
@@ -1827,48 +1915,19 @@ inline void requestRoutesJournalEventLogEntry(App& app)
 
         const std::string& targetID = param;
 
-        // Go through the log files and check the unique ID for each
-        // entry to find the target entry
-        std::vector<std::filesystem::path> redfishLogFiles;
-        getRedfishLogFiles(redfishLogFiles);
         std::string logEntry;
-
-        // Oldest logs are in the last file, so start there and loop
-        // backwards
-        for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend();
-             it++)
+        if (EventLogIndex::getInstance().readEntry(targetID, logEntry))
         {
-            std::ifstream logStream(*it);
-            if (!logStream.is_open())
+            nlohmann::json::object_t bmcLogEntry;
+            LogParseError status = fillEventLogEntryJson(targetID, logEntry,
+                                                         bmcLogEntry);
+            if (status != LogParseError::success)
             {
-                continue;
-            }
-
-            // Reset the unique ID on the first entry
-            bool firstEntry = true;
-            while (std::getline(logStream, logEntry))
-            {
-                std::string idStr;
-                if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-                {
-                    continue;
-                }
-                firstEntry = false;
-
-                if (idStr == targetID)
-                {
-                    nlohmann::json::object_t bmcLogEntry;
-                    LogParseError status =
-                        fillEventLogEntryJson(idStr, logEntry, bmcLogEntry);
-                    if (status != LogParseError::success)
-                    {
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                    asyncResp->res.jsonValue.update(bmcLogEntry);
-                    return;
-                }
+                messages::internalError(asyncResp->res);
+                return;
             }
+            asyncResp->res.jsonValue.update(bmcLogEntry);
+            return;
         }
         // Requested ID was not found
         messages::resourceNotFound(asyncResp->res, "LogEntry", targetID);
@@ -2326,32 +2385,75 @@ inline bool
     return true;
 }
 
+// The indexes made of the host log files, by path.  Only used from the main
+// io_context.  Workers are handed a copy, and hand back the indexes of the
+// files that are there now.
+using HostLoggerIndexes =
+    std::map<std::string, std::shared_ptr<const GzFileIndex>>;
+
+inline HostLoggerIndexes& getHostLoggerIndexes()
+{
+    static HostLoggerIndexes indexes;
+    return indexes;
+}
+
 inline bool getHostLoggerEntries(
     const std::vector<std::filesystem::path>& hostLoggerFiles, uint64_t skip,
-    uint64_t top, std::vector<std::string>& logEntries, size_t& logCount)
+    uint64_t top, HostLoggerIndexes& indexes,
+    std::vector<std::string>& logEntries, size_t& logCount)
 {
-    GzFileReader logFile;
-
-    // Go though all log files and expose host logs.
+    HostLoggerIndexes current;
+    std::vector<std::shared_ptr<const GzFileIndex>> files;
     for (const std::filesystem::path& it : hostLoggerFiles)
     {
-        if (!logFile.gzGetLines(it.string(), skip, top, logEntries, logCount))
+        auto known = indexes.find(it.string());
+        if (known != indexes.end() && known->second->isCurrent())
         {
-            BMCWEB_LOG_ERROR("fail to expose host logs");
-            return false;
+            files.emplace_back(known->second);
         }
-    }
-    // Get lastMessage from constructor by getter
-    std::string lastMessage = logFile.getLastMessage();
-    if (!lastMessage.empty())
-    {
-        logCount++;
-        if (logCount > skip && logCount <= (skip + top))
+        else
         {
-            logEntries.push_back(lastMessage);
+            auto index = std::make_shared<GzFileIndex>(it);
+            if (!index->build())
+            {
+                BMCWEB_LOG_ERROR("fail to expose host logs");
+                return false;
+            }
+            files.emplace_back(std::move(index));
         }
+        current.emplace(it.string(), files.back());
     }
-    return true;
+    indexes = std::move(current);
+    return readHostLogEntries(files, skip, top, logEntries, logCount);
+}
+
+struct HostLoggerEntries
+{
+    bool hasFiles = false;
+    bool ok = false;
+    // Only the entries selected by skip and top
+    std::vector<std::string> entries;
+    size_t logCount = 0;
+    HostLoggerIndexes indexes;
+};
+
+// Indexing a file that's new or has changed decompresses all of it, so this
+// is run on a worker thread
+inline HostLoggerEntries readHostLoggerEntries(uint64_t skip, uint64_t top,
+                                               HostLoggerIndexes indexes)
+{
+    HostLoggerEntries result;
+    std::vector<std::filesystem::path> hostLoggerFiles;
+    if (!getHostLoggerFiles(hostLoggerFolderPath, hostLoggerFiles))
+    {
+        BMCWEB_LOG_DEBUG("Failed to get host log file path");
+        return result;
+    }
+    result.hasFiles = true;
+    result.ok = getHostLoggerEntries(hostLoggerFiles, skip, top, indexes,
+                                     result.entries, result.logCount);
+    result.indexes = std::move(indexes);
+    return result;
 }
 
 inline void fillHostLoggerEntryJson(std::string_view logEntryID,
@@ -2454,44 +2556,42 @@ inline void requestRoutesSystemHostLoggerCollection(App& app)
         logEntryArray = nlohmann::json::array();
         asyncResp->res.jsonValue["Members@odata.count"] = 0;
 
-        std::vector<std::filesystem::path> hostLoggerFiles;
-        if (!getHostLoggerFiles(hostLoggerFolderPath, hostLoggerFiles))
-        {
-            BMCWEB_LOG_DEBUG("Failed to get host log file path");
-            return;
-        }
         // If we weren't provided top and skip limits, use the defaults.
         size_t skip = delegatedQuery.skip.value_or(0);
         size_t top = delegatedQuery.top.value_or(query_param::Query::maxTop);
-        size_t logCount = 0;
-        // This vector only store the entries we want to expose that
-        // control by skip and top.
-        std::vector<std::string> logEntries;
-        if (!getHostLoggerEntries(hostLoggerFiles, skip, top, logEntries,
-                                  logCount))
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        // If vector is empty, that means skip value larger than total
-        // log count
-        if (logEntries.empty())
-        {
-            asyncResp->res.jsonValue["Members@odata.count"] = logCount;
-            return;
-        }
-        if (!logEntries.empty())
-        {
-            for (size_t i = 0; i < logEntries.size(); i++)
+        bool queued = bmcweb::WorkerPool::getInstance().post(
+            "HostLoggerEntries",
+            [skip, top, indexes{getHostLoggerIndexes()}]() {
+            return readHostLoggerEntries(skip, top, indexes);
+        },
+            [asyncResp, skip, top](HostLoggerEntries&& result) {
+            if (!result.hasFiles)
+            {
+                return;
+            }
+            if (!result.ok)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            getHostLoggerIndexes() = std::move(result.indexes);
+            asyncResp->res.jsonValue["Members@odata.count"] = result.logCount;
+            // If vector is empty, that means skip value larger than total
+            // log count
+            if (result.entries.empty())
+            {
+                return;
+            }
+            nlohmann::json::array_t members;
+            for (size_t i = 0; i < result.entries.size(); i++)
             {
                 nlohmann::json::object_t hostLogEntry;
-                fillHostLoggerEntryJson(std::to_string(skip + i), logEntries[i],
-                                        hostLogEntry);
-                logEntryArray.emplace_back(std::move(hostLogEntry));
+                fillHostLoggerEntryJson(std::to_string(skip + i),
+                                        result.entries[i], hostLogEntry);
+                members.emplace_back(std::move(hostLogEntry));
             }
-
-            asyncResp->res.jsonValue["Members@odata.count"] = logCount;
-            if (skip + top < logCount)
+            asyncResp->res.jsonValue["Members"] = std::move(members);
+            if (skip + top < result.logCount)
             {
                 asyncResp->res.jsonValue["Members@odata.nextLink"] =
                     std::format(
@@ -2499,6 +2599,12 @@ inline void requestRoutesSystemHostLoggerCollection(App& app)
                         BMCWEB_REDFISH_SYSTEM_URI_NAME) +
                     std::to_string(skip + top);
             }
+        });
+        if (!queued)
+        {
+            messages::serviceTemporarilyUnavailable(
+                asyncResp->res,
+                std::to_string(bmcweb::WorkerPool::retryAfter.count()));
         }
     });
 }
@@ -2541,36 +2647,44 @@ inline void requestRoutesSystemHostLoggerLogEntry(App& app)
             return;
         }
 
-        std::vector<std::filesystem::path> hostLoggerFiles;
-        if (!getHostLoggerFiles(hostLoggerFolderPath, hostLoggerFiles))
-        {
-            BMCWEB_LOG_DEBUG("Failed to get host log file path");
-            return;
-        }
-
-        size_t logCount = 0;
-        size_t top = 1;
-        std::vector<std::string> logEntries;
         // We can get specific entry by skip and top. For example, if we
         // want to get nth entry, we can set skip = n-1 and top = 1 to
         // get that entry
-        if (!getHostLoggerEntries(hostLoggerFiles, idInt, top, logEntries,
-                                  logCount))
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+        bool queued = bmcweb::WorkerPool::getInstance().post(
+            "HostLoggerEntries",
+            [idInt, indexes{getHostLoggerIndexes()}]() {
+            return readHostLoggerEntries(idInt, 1, indexes);
+        },
+            [asyncResp, param](HostLoggerEntries&& result) {
+            if (!result.hasFiles)
+            {
+                return;
+            }
+            if (!result.ok)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            getHostLoggerIndexes() = std::move(result.indexes);
+
+            if (!result.entries.empty())
+            {
+                nlohmann::json::object_t hostLogEntry;
+                fillHostLoggerEntryJson(param, result.entries[0],
+                                        hostLogEntry);
+                asyncResp->res.jsonValue.update(hostLogEntry);
+                return;
+            }
 
-        if (!logEntries.empty())
+            // Requested ID was not found
+            messages::resourceNotFound(asyncResp->res, "LogEntry", param);
+        });
+        if (!queued)
         {
-            nlohmann::json::object_t hostLogEntry;
-            fillHostLoggerEntryJson(targetID, logEntries[0], hostLogEntry);
-            asyncResp->res.jsonValue.update(hostLogEntry);
-            return;
+            messages::serviceTemporarilyUnavailable(
+                asyncResp->res,
+                std::to_string(bmcweb::WorkerPool::retryAfter.count()));
         }
-
-        // Requested ID was not found
-        messages::resourceNotFound(asyncResp->res, "LogEntry", param);
     });
 }
 
@@ -2780,6 +2894,286 @@ static int
     return 0;
 }
 
+inline bool getJournalCursor(sd_journal* journal, std::string& cursor)
+{
+    char* cursorTmp = nullptr;
+    int ret = sd_journal_get_cursor(journal, &cursorTmp);
+    if (ret < 0)
+    {
+        BMCWEB_LOG_ERROR("Failed to read entry cursor: {}", strerror(-ret));
+        return false;
+    }
+    std::unique_ptr<char, decltype(&free)> cursorPtr(cursorTmp, free);
+    cursor = cursorTmp;
+    return true;
+}
+
+// Makes the ID of the entry the journal is at, without walking from the head
+// of the journal.  Entries before it from the same boot with the same
+// timestamp are counted, so that the ID is the one getUniqueEntryID() gives
+// on a walk from the head.  Leaves the journal at the same entry.
+inline bool getJournalEntryID(sd_journal* journal, std::string& entryID)
+{
+    uint64_t curTs = 0;
+    sd_id128_t curBootID{};
+    int ret = sd_journal_get_monotonic_usec(journal, &curTs, &curBootID);
+    if (ret < 0)
+    {
+        BMCWEB_LOG_ERROR("Failed to read entry timestamp: {}", strerror(-ret));
+        return false;
+    }
+    uint64_t index = 0;
+    uint64_t moved = 0;
+    while (sd_journal_previous(journal) > 0)
+    {
+        moved++;
+        uint64_t prevTs = 0;
+        sd_id128_t prevBootID{};
+        if (sd_journal_get_monotonic_usec(journal, &prevTs, &prevBootID) < 0 ||
+            prevTs != curTs || sd_id128_equal(prevBootID, curBootID) == 0)
+        {
+            break;
+        }
+        index++;
+    }
+    if (moved > 0 && sd_journal_next_skip(journal, moved) < 0)
+    {
+        return false;
+    }
+
+    std::array<char, SD_ID128_STRING_MAX> bootIDStr{};
+    sd_id128_to_string(curBootID, bootIDStr.data());
+    entryID = std::format("{}_{}", bootIDStr.data(), curTs);
+    if (index > 0)
+    {
+        entryID += "_" + std::to_string(index);
+    }
+    return true;
+}
+
+// How many entries the journal held when it was last counted.  The entries
+// after the tail are all that need counting next time, as long as the oldest
+// entry is still the head.
+struct BMCJournalCount
+{
+    std::string head;
+    std::string tail;
+    uint64_t entries = 0;
+};
+
+// Only used from the main io_context
+inline BMCJournalCount& getBMCJournalCount()
+{
+    static BMCJournalCount count;
+    return count;
+}
+
+inline bool countBMCJournal(sd_journal* journal, BMCJournalCount& count)
+{
+    std::string head;
+    int ret = sd_journal_seek_head(journal);
+    if (ret < 0 || sd_journal_next(journal) <= 0)
+    {
+        count = BMCJournalCount();
+        return ret >= 0;
+    }
+    if (!getJournalCursor(journal, head))
+    {
+        return false;
+    }
+    bool resume = !count.tail.empty() && head == count.head &&
+                  sd_journal_seek_cursor(journal, count.tail.c_str()) >= 0 &&
+                  sd_journal_next(journal) > 0 &&
+                  sd_journal_test_cursor(journal, count.tail.c_str()) > 0;
+    if (!resume)
+    {
+        // Older entries were vacuumed, or the journal was never counted
+        sd_journal_seek_head(journal);
+        sd_journal_next(journal);
+        count.head = std::move(head);
+        count.entries = 1;
+    }
+    while (sd_journal_next(journal) > 0)
+    {
+        count.entries++;
+    }
+    ret = sd_journal_seek_tail(journal);
+    if (ret < 0 || sd_journal_previous(journal) <= 0)
+    {
+        return false;
+    }
+    return getJournalCursor(journal, count.tail);
+}
+
+// Which entries of the journal a request wants.  Without a cursor, paging
+// starts from the oldest entry, or from the newest going backwards, after
+// skipping skip entries.  With one, it carries on from the entry after it,
+// and skip isn't used.
+struct BMCJournalPage
+{
+    size_t skip = 0;
+    size_t top = query_param::Query::maxTop;
+    bool newestFirst = false;
+    std::string cursor;
+};
+
+// Reads the "order" and "cursor" parameters.  They don't start with $, so the
+// generic query handling leaves them alone.
+inline bool getBMCJournalPage(boost::urls::params_view params,
+                              BMCJournalPage& page, crow::Response& res)
+{
+    auto order = params.find("order");
+    if (order != params.end())
+    {
+        if ((*order).value == "newest")
+        {
+            page.newestFirst = true;
+        }
+        else if ((*order).value != "oldest")
+        {
+            messages::queryParameterValueFormatError(res, (*order).value,
+                                                     "order");
+            return false;
+        }
+    }
+    auto cursor = params.find("cursor");
+    if (cursor != params.end())
+    {
+        if ((*cursor).value.empty())
+        {
+            messages::queryParameterValueFormatError(res, "", "cursor");
+            return false;
+        }
+        page.cursor = (*cursor).value;
+    }
+    return true;
+}
+
+struct BMCJournalEntries
+{
+    bool ok = false;
+    bool badCursor = false;
+    nlohmann::json::array_t members;
+    uint64_t entryCount = 0;
+    // The cursor of the last entry returned, if there are more after it
+    std::string nextCursor;
+    BMCJournalCount count;
+};
+
+// Counting the journal can mean walking all of it, so this is run on a worker
+// thread.  It must not touch any state shared with the main thread, so the
+// count from last time is passed in, and the new one handed back.
+inline BMCJournalEntries readBMCJournalEntries(const BMCJournalPage& page,
+                                               BMCJournalCount count)
+{
+    BMCJournalEntries entries;
+
+    sd_journal* journalTmp = nullptr;
+    int ret = sd_journal_open(&journalTmp, SD_JOURNAL_LOCAL_ONLY);
+    if (ret < 0)
+    {
+        BMCWEB_LOG_ERROR("failed to open journal: {}", strerror(-ret));
+        return entries;
+    }
+    std::unique_ptr<sd_journal, decltype(&sd_journal_close)> journal(
+        journalTmp, sd_journal_close);
+    journalTmp = nullptr;
+
+    if (!countBMCJournal(journal.get(), count))
+    {
+        return entries;
+    }
+    entries.entryCount = count.entries;
+    entries.count = std::move(count);
+
+    auto step = [&page, &journal]() {
+        if (page.newestFirst)
+        {
+            return sd_journal_previous(journal.get());
+        }
+        return sd_journal_next(journal.get());
+    };
+    // Whether the journal is already at the first entry of the page
+    bool atFirst = false;
+    if (page.cursor.empty())
+    {
+        ret = page.newestFirst ? sd_journal_seek_tail(journal.get())
+                               : sd_journal_seek_head(journal.get());
+        if (ret >= 0 && page.skip > 0)
+        {
+            ret = page.newestFirst
+                      ? sd_journal_previous_skip(journal.get(), page.skip)
+                      : sd_journal_next_skip(journal.get(), page.skip);
+        }
+    }
+    else
+    {
+        const char* cursor = page.cursor.c_str();
+        ret = sd_journal_seek_cursor(journal.get(), cursor);
+        if (ret < 0)
+        {
+            entries.badCursor = true;
+            return entries;
+        }
+        // This lands on the entry the cursor names, or on the one after it
+        // if it has been vacuumed since
+        ret = step();
+        if (ret > 0)
+        {
+            atFirst = sd_journal_test_cursor(journal.get(), cursor) <= 0;
+        }
+    }
+    if (ret < 0)
+    {
+        BMCWEB_LOG_ERROR("failed to seek in journal: {}", strerror(-ret));
+        return entries;
+    }
+
+    while (entries.members.size() < page.top)
+    {
+        if (!atFirst)
+        {
+            ret = step();
+            if (ret < 0)
+            {
+                return entries;
+            }
+            if (ret == 0)
+            {
+                break;
+            }
+        }
+        atFirst = false;
+
+        std::string idStr;
+        if (!getJournalEntryID(journal.get(), idStr))
+        {
+            return entries;
+        }
+        nlohmann::json::object_t bmcJournalLogEntry;
+        if (fillBMCJournalLogEntryJson(idStr, journal.get(),
+                                       bmcJournalLogEntry) != 0)
+        {
+            return entries;
+        }
+        entries.members.emplace_back(std::move(bmcJournalLogEntry));
+    }
+    if (!entries.members.empty() && entries.members.size() == page.top)
+    {
+        std::string cursor;
+        if (!getJournalCursor(journal.get(), cursor))
+        {
+            return entries;
+        }
+        if (step() > 0)
+        {
+            entries.nextCursor = std::move(cursor);
+        }
+    }
+    entries.ok = true;
+    return entries;
+}
+
 inline void requestRoutesBMCJournalLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Managers/<str>/LogServices/Journal/Entries/")
@@ -2805,8 +3199,13 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
             return;
         }
 
-        size_t skip = delegatedQuery.skip.value_or(0);
-        size_t top = delegatedQuery.top.value_or(query_param::Query::maxTop);
+        BMCJournalPage page;
+        page.skip = delegatedQuery.skip.value_or(0);
+        page.top = delegatedQuery.top.value_or(query_param::Query::maxTop);
+        if (!getBMCJournalPage(req.url().params(), page, asyncResp->res))
+        {
+            return;
+        }
 
         // Collections don't include the static data added by SubRoute
         // because it has a duplicate entry for members
@@ -2818,58 +3217,53 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
         asyncResp->res.jsonValue["Name"] = "Open BMC Journal Entries";
         asyncResp->res.jsonValue["Description"] =
             "Collection of BMC Journal Entries";
-        nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
-        logEntryArray = nlohmann::json::array();
-
-        // Go through the journal and use the timestamp to create a
-        // unique ID for each entry
-        sd_journal* journalTmp = nullptr;
-        int ret = sd_journal_open(&journalTmp, SD_JOURNAL_LOCAL_ONLY);
-        if (ret < 0)
-        {
-            BMCWEB_LOG_ERROR("failed to open journal: {}", strerror(-ret));
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        std::unique_ptr<sd_journal, decltype(&sd_journal_close)> journal(
-            journalTmp, sd_journal_close);
-        journalTmp = nullptr;
-        uint64_t entryCount = 0;
-        // Reset the unique ID on the first entry
-        bool firstEntry = true;
-        SD_JOURNAL_FOREACH(journal.get())
-        {
-            entryCount++;
-            // Handle paging using skip (number of entries to skip from
-            // the start) and top (number of entries to display)
-            if (entryCount <= skip || entryCount > skip + top)
-            {
-                continue;
-            }
-
-            std::string idStr;
-            if (!getUniqueEntryID(journal.get(), idStr, firstEntry))
+        bool topGiven = delegatedQuery.top.has_value();
+        bool queued = bmcweb::WorkerPool::getInstance().post(
+            "BMCJournalEntries",
+            [page, count{getBMCJournalCount()}]() {
+            return readBMCJournalEntries(page, count);
+        },
+            [asyncResp, page, topGiven](BMCJournalEntries&& entries) {
+            if (entries.badCursor)
             {
-                continue;
+                messages::queryParameterValueFormatError(asyncResp->res,
+                                                         page.cursor, "cursor");
+                return;
             }
-            firstEntry = false;
-
-            nlohmann::json::object_t bmcJournalLogEntry;
-            if (fillBMCJournalLogEntryJson(idStr, journal.get(),
-                                           bmcJournalLogEntry) != 0)
+            if (!entries.ok)
             {
                 messages::internalError(asyncResp->res);
                 return;
             }
-            logEntryArray.emplace_back(std::move(bmcJournalLogEntry));
-        }
-        asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
-        if (skip + top < entryCount)
+            getBMCJournalCount() = std::move(entries.count);
+            asyncResp->res.jsonValue["Members"] = std::move(entries.members);
+            asyncResp->res.jsonValue["Members@odata.count"] =
+                entries.entryCount;
+            if (!entries.nextCursor.empty())
+            {
+                // A cursor stays on the right entry as the journal grows and
+                // is vacuumed, where $skip would drift
+                boost::urls::url nextLink = boost::urls::format(
+                    "/redfish/v1/Managers/{}/LogServices/Journal/Entries",
+                    BMCWEB_REDFISH_MANAGER_URI_NAME);
+                if (topGiven)
+                {
+                    nextLink.params().set("$top", std::to_string(page.top));
+                }
+                if (page.newestFirst)
+                {
+                    nextLink.params().set("order", "newest");
+                }
+                nextLink.params().set("cursor", entries.nextCursor);
+                asyncResp->res.jsonValue["Members@odata.nextLink"] =
+                    std::move(nextLink);
+            }
+        });
+        if (!queued)
         {
-            asyncResp->res
-                .jsonValue["Members@odata.nextLink"] = boost::urls::format(
-                "/redfish/v1/Managers/{}/LogServices/Journal/Entries?$skip={}",
-                BMCWEB_REDFISH_MANAGER_URI_NAME, std::to_string(skip + top));
+            messages::serviceTemporarilyUnavailable(
+                asyncResp->res,
+                std::to_string(bmcweb::WorkerPool::retryAfter.count()));
         }
     });
 }
@@ -719,6 +719,20 @@ inline void getDimmPartitionData(std::shared_ptr<bmcweb::AsyncResp> asyncResp,
     );
 }
 
+inline void
+    addDimmCommonProperties(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                            const std::string& dimmId)
+{
+    asyncResp->res.jsonValue["@odata.type"] = "#Memory.v1_11_0.Memory";
+    asyncResp->res.jsonValue["@odata.id"] = boost::urls::format(
+        "/redfish/v1/Systems/{}/Memory/{}", BMCWEB_REDFISH_SYSTEM_URI_NAME,
+        dimmId);
+
+    asyncResp->res.jsonValue["Metrics"]["@odata.id"] = boost::urls::format(
+        "/redfish/v1/Systems/{}/Memory/{}/MemoryMetrics",
+        BMCWEB_REDFISH_SYSTEM_URI_NAME, dimmId);
+}
+
 inline void getDimmData(std::shared_ptr<bmcweb::AsyncResp> asyncResp,
                         const std::string& dimmId)
 {
@@ -776,19 +790,46 @@ inline void getDimmData(std::shared_ptr<bmcweb::AsyncResp> asyncResp,
             return;
         }
         // Set @odata only if object is found
-        asyncResp->res.jsonValue["@odata.type"] = "#Memory.v1_11_0.Memory";
-        asyncResp->res.jsonValue["@odata.id"] =
-            boost::urls::format("/redfish/v1/Systems/{}/Memory/{}",
-                                BMCWEB_REDFISH_SYSTEM_URI_NAME, dimmId);
-
-        asyncResp->res.jsonValue["Metrics"]["@odata.id"] = boost::urls::format(
-            "/redfish/v1/Systems/{}/Memory/{}/MemoryMetrics",
-            BMCWEB_REDFISH_SYSTEM_URI_NAME, dimmId);
-
-        return;
+        addDimmCommonProperties(asyncResp, dimmId);
     });
 }
 
+// Fills in a member of the Memory collection, when it's expanded, from the
+// properties of the DIMM and its partitions.  Like getDimmData, the
+// properties each service has for the DIMM are assembled separately.
+inline void fillExpandedDimm(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const collection_util::ExpandedMember& dimm,
+    const collection_util::ExpandedMemberObjects& objects)
+{
+    addDimmCommonProperties(asyncResp, dimm.id);
+    dbus::utility::DBusPropertiesMap properties;
+    for (const dbus::utility::DBusInterfacesMap& interfaces :
+         objects.interfaces)
+    {
+        properties.clear();
+        for (const auto& [interface, interfaceProperties] : interfaces)
+        {
+            properties.insert(properties.end(), interfaceProperties.begin(),
+                              interfaceProperties.end());
+        }
+        assembleDimmProperties(dimm.id, asyncResp, properties,
+                               ""_json_pointer);
+    }
+    for (const auto& [objectPath, interfaces] : objects.children)
+    {
+        for (const auto& [interface, partitionProperties] : interfaces)
+        {
+            if (interface ==
+                "xyz.openbmc_project.Inventory.Item.PersistentMemory.Partition")
+            {
+                assembleDimmPartitionData(asyncResp, partitionProperties,
+                                          "/Regions"_json_pointer);
+            }
+        }
+    }
+}
+
 inline void requestRoutesMemoryCollection(App& app)
 {
     /**
@@ -800,7 +841,12 @@ inline void requestRoutesMemoryCollection(App& app)
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                    const std::string& systemName) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateExpandLevel = 1,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -826,6 +872,16 @@ inline void requestRoutesMemoryCollection(App& app)
 
         constexpr std::array<std::string_view, 1> interfaces{
             "xyz.openbmc_project.Inventory.Item.Dimm"};
+        if (collection_util::expandsMembers(delegatedQuery))
+        {
+            collection_util::getCollectionMembersExpanded(
+                asyncResp,
+                boost::urls::format("/redfish/v1/Systems/{}/Memory",
+                                    BMCWEB_REDFISH_SYSTEM_URI_NAME),
+                interfaces, "/xyz/openbmc_project/inventory",
+                fillExpandedDimm);
+            return;
+        }
         collection_util::getCollectionMembers(
             asyncResp,
             boost::urls::format("/redfish/v1/Systems/{}/Memory",
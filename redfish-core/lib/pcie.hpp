@@ -111,54 +111,6 @@ static inline void getValidPCIeDevicePath(
     });
 }
 
-static inline void handlePCIeDeviceCollectionGet(
-    crow::App& app, const crow::Request& req,
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& systemName)
-{
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
-    {
-        return;
-    }
-    if constexpr (BMCWEB_EXPERIMENTAL_REDFISH_MULTI_COMPUTER_SYSTEM)
-    {
-        // Option currently returns no systems.  TBD
-        messages::resourceNotFound(asyncResp->res, "ComputerSystem",
-                                   systemName);
-        return;
-    }
-    if (systemName != BMCWEB_REDFISH_SYSTEM_URI_NAME)
-    {
-        messages::resourceNotFound(asyncResp->res, "ComputerSystem",
-                                   systemName);
-        return;
-    }
-
-    asyncResp->res.addHeader(boost::beast::http::field::link,
-                             "</redfish/v1/JsonSchemas/PCIeDeviceCollection/"
-                             "PCIeDeviceCollection.json>; rel=describedby");
-    asyncResp->res.jsonValue["@odata.type"] =
-        "#PCIeDeviceCollection.PCIeDeviceCollection";
-    asyncResp->res.jsonValue["@odata.id"] = std::format(
-        "/redfish/v1/Systems/{}/PCIeDevices", BMCWEB_REDFISH_SYSTEM_URI_NAME);
-    asyncResp->res.jsonValue["Name"] = "PCIe Device Collection";
-    asyncResp->res.jsonValue["Description"] = "Collection of PCIe Devices";
-
-    pcie_util::getPCIeDeviceList(asyncResp,
-                                 nlohmann::json::json_pointer("/Members"));
-}
-
-inline void requestRoutesSystemPCIeDeviceCollection(App& app)
-{
-    /**
-     * Functions triggers appropriate requests on DBus
-     */
-    BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/PCIeDevices/")
-        .privileges(redfish::privileges::getPCIeDeviceCollection)
-        .methods(boost::beast::http::verb::get)(
-            std::bind_front(handlePCIeDeviceCollectionGet, std::ref(app)));
-}
-
 inline void addPCIeSlotProperties(
     crow::Response& res, const boost::system::error_code& ec,
     const dbus::utility::DBusPropertiesMap& pcieSlotProperties)
@@ -357,6 +309,68 @@ inline void
     });
 }
 
+inline void
+    addPCIeDeviceAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                       const dbus::utility::DBusPropertiesMap& assetList)
+{
+    const std::string* manufacturer = nullptr;
+    const std::string* model = nullptr;
+    const std::string* partNumber = nullptr;
+    const std::string* serialNumber = nullptr;
+    const std::string* sparePartNumber = nullptr;
+    const std::string* deviceType = nullptr;
+
+    const bool success = sdbusplus::unpackPropertiesNoThrow(
+        dbus_utils::UnpackErrorPrinter(), assetList, "Manufacturer",
+        manufacturer, "Model", model, "PartNumber", partNumber,
+        "SerialNumber", serialNumber, "SparePartNumber", sparePartNumber,
+        "DeviceType", deviceType);
+
+    if (!success)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+
+    if (manufacturer != nullptr)
+    {
+        asyncResp->res.jsonValue["Manufacturer"] = *manufacturer;
+    }
+    if (model != nullptr)
+    {
+        asyncResp->res.jsonValue["Model"] = *model;
+    }
+
+    if (partNumber != nullptr && !partNumber->empty() &&
+        *partNumber != "Not Available")
+    {
+        asyncResp->res.jsonValue["PartNumber"] = *partNumber;
+    }
+    else
+    {
+        messages::propertyNotUpdated(asyncResp->res, "PartNumber");
+    }
+
+    if (serialNumber != nullptr && !serialNumber->empty() &&
+        *serialNumber != "Not Available")
+    {
+        asyncResp->res.jsonValue["SerialNumber"] = *serialNumber;
+    }
+    else
+    {
+        messages::propertyNotUpdated(asyncResp->res, "SerialNumber");
+    }
+
+    if (sparePartNumber != nullptr && !sparePartNumber->empty())
+    {
+        asyncResp->res.jsonValue["SparePartNumber"] = *sparePartNumber;
+    }
+    if (deviceType != nullptr && !deviceType->empty())
+    {
+        asyncResp->res.jsonValue["DeviceType"] = *deviceType;
+    }
+}
+
 inline void
     getPCIeDeviceAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                        const std::string& pcieDevicePath,
@@ -378,62 +392,7 @@ inline void
             }
             return;
         }
-
-        const std::string* manufacturer = nullptr;
-        const std::string* model = nullptr;
-        const std::string* partNumber = nullptr;
-        const std::string* serialNumber = nullptr;
-        const std::string* sparePartNumber = nullptr;
-        const std::string* deviceType = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), assetList, "Manufacturer",
-            manufacturer, "Model", model, "PartNumber", partNumber,
-            "SerialNumber", serialNumber, "SparePartNumber", sparePartNumber, "DeviceType", deviceType);
-
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (manufacturer != nullptr)
-        {
-            asyncResp->res.jsonValue["Manufacturer"] = *manufacturer;
-        }
-        if (model != nullptr)
-        {
-            asyncResp->res.jsonValue["Model"] = *model;
-        }
-
-        if (partNumber != nullptr && !partNumber->empty() &&
-            *partNumber != "Not Available")
-        {
-            asyncResp->res.jsonValue["PartNumber"] = *partNumber;
-        }
-        else
-        {
-            messages::propertyNotUpdated(asyncResp->res, "PartNumber");
-        }
-
-        if (serialNumber != nullptr && !serialNumber->empty() &&
-            *serialNumber != "Not Available")
-        {
-            asyncResp->res.jsonValue["SerialNumber"] = *serialNumber;
-        }
-        else
-        {
-            messages::propertyNotUpdated(asyncResp->res, "SerialNumber");
-        }
-
-        if (sparePartNumber != nullptr && !sparePartNumber->empty())
-        {
-            asyncResp->res.jsonValue["SparePartNumber"] = *sparePartNumber;
-        }
-        if (deviceType != nullptr && !deviceType->empty())
-        {
-            asyncResp->res.jsonValue["DeviceType"] = *deviceType;
-        }
+        addPCIeDeviceAsset(asyncResp, assetList);
     });
 }
 
@@ -592,6 +551,132 @@ inline void afterGetValidPcieDevicePath(
         std::bind_front(afterGetPCIeDeviceSlotPath, asyncResp));
 }
 
+// Fills in a member of the PCIeDevices collection, when it's expanded, from
+// the properties of the device.  Each interface is read on its own, as
+// handlePCIeDeviceGet does.  Only the slot still needs looking up.
+inline void fillExpandedPCIeDevice(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const collection_util::ExpandedMember& pcieDevice,
+    const collection_util::ExpandedMemberObjects& objects)
+{
+    addPCIeDeviceCommonProperties(asyncResp, pcieDevice.id);
+
+    for (const dbus::utility::DBusInterfacesMap& interfaces :
+         objects.interfaces)
+    {
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface == "xyz.openbmc_project.Inventory.Decorator.Asset")
+            {
+                addPCIeDeviceAsset(asyncResp, properties);
+            }
+            else if (interface == "xyz.openbmc_project.Inventory.Item")
+            {
+                const bool* present = nullptr;
+                if (!sdbusplus::unpackPropertiesNoThrow(
+                        dbus_utils::UnpackErrorPrinter(), properties,
+                        "Present", present))
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                if (present != nullptr && !*present)
+                {
+                    asyncResp->res.jsonValue["Status"]["State"] = "Absent";
+                }
+            }
+            else if (interface ==
+                     "xyz.openbmc_project.State.Decorator.OperationalStatus")
+            {
+                const bool* functional = nullptr;
+                if (!sdbusplus::unpackPropertiesNoThrow(
+                        dbus_utils::UnpackErrorPrinter(), properties,
+                        "Functional", functional))
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                if (functional != nullptr && !*functional)
+                {
+                    asyncResp->res.jsonValue["Status"]["Health"] = "Critical";
+                }
+            }
+            else if (interface ==
+                     "xyz.openbmc_project.Inventory.Item.PCIeDevice")
+            {
+                addPCIeDeviceProperties(asyncResp, pcieDevice.id, properties);
+            }
+        }
+    }
+
+    getPCIeDeviceSlotPath(
+        pcieDevice.path, asyncResp,
+        std::bind_front(afterGetPCIeDeviceSlotPath, asyncResp));
+}
+
+static inline void handlePCIeDeviceCollectionGet(
+    crow::App& app, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::string& systemName)
+{
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateExpandLevel = 1,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
+    {
+        return;
+    }
+    if constexpr (BMCWEB_EXPERIMENTAL_REDFISH_MULTI_COMPUTER_SYSTEM)
+    {
+        // Option currently returns no systems.  TBD
+        messages::resourceNotFound(asyncResp->res, "ComputerSystem",
+                                   systemName);
+        return;
+    }
+    if (systemName != BMCWEB_REDFISH_SYSTEM_URI_NAME)
+    {
+        messages::resourceNotFound(asyncResp->res, "ComputerSystem",
+                                   systemName);
+        return;
+    }
+
+    asyncResp->res.addHeader(boost::beast::http::field::link,
+                             "</redfish/v1/JsonSchemas/PCIeDeviceCollection/"
+                             "PCIeDeviceCollection.json>; rel=describedby");
+    asyncResp->res.jsonValue["@odata.type"] =
+        "#PCIeDeviceCollection.PCIeDeviceCollection";
+    asyncResp->res.jsonValue["@odata.id"] = std::format(
+        "/redfish/v1/Systems/{}/PCIeDevices", BMCWEB_REDFISH_SYSTEM_URI_NAME);
+    asyncResp->res.jsonValue["Name"] = "PCIe Device Collection";
+    asyncResp->res.jsonValue["Description"] = "Collection of PCIe Devices";
+
+    if (collection_util::expandsMembers(delegatedQuery))
+    {
+        collection_util::getCollectionMembersExpanded(
+            asyncResp,
+            boost::urls::format("/redfish/v1/Systems/{}/PCIeDevices",
+                                BMCWEB_REDFISH_SYSTEM_URI_NAME),
+            pcieDeviceInterface, inventoryPath, fillExpandedPCIeDevice);
+        return;
+    }
+
+    pcie_util::getPCIeDeviceList(asyncResp,
+                                 nlohmann::json::json_pointer("/Members"));
+}
+
+inline void requestRoutesSystemPCIeDeviceCollection(App& app)
+{
+    /**
+     * Functions triggers appropriate requests on DBus
+     */
+    BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/PCIeDevices/")
+        .privileges(redfish::privileges::getPCIeDeviceCollection)
+        .methods(boost::beast::http::verb::get)(
+            std::bind_front(handlePCIeDeviceCollectionGet, std::ref(app)));
+}
+
 inline void
     handlePCIeDeviceGet(App& app, const crow::Request& req,
                         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -23,8 +23,11 @@
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
 #include "utils/json_utils.hpp"
+#include "worker_pool.hpp"
 
+#include <boost/asio/ip/address.hpp>
 #include <boost/url/format.hpp>
+#include <boost/url/url.hpp>
 
 namespace redfish
 {
@@ -192,6 +195,48 @@ inline void handleSessionCollectionMembersGet(
     asyncResp->res.jsonValue = getSessionCollectionMembers();
 }
 
+inline void afterSessionCollectionPostAuthenticate(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::string& username, const std::optional<std::string>& clientId,
+    const boost::urls::url& url, const boost::asio::ip::address& ipAddress,
+    int pamrc)
+{
+    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
+    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    {
+        messages::resourceAtUriUnauthorized(asyncResp->res, url,
+                                            "Invalid username or password");
+        return;
+    }
+
+    // User is authenticated - create session
+    std::shared_ptr<persistent_data::UserSession> session =
+        persistent_data::SessionStore::getInstance().generateUserSession(
+            username, ipAddress, clientId,
+            persistent_data::PersistenceType::TIMEOUT, isConfigureSelfOnly);
+    if (session == nullptr)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+
+    asyncResp->res.addHeader("X-Auth-Token", session->sessionToken);
+    asyncResp->res.addHeader(
+        "Location", "/redfish/v1/SessionService/Sessions/" + session->uniqueId);
+    asyncResp->res.result(boost::beast::http::status::created);
+    if (session->isConfigureSelfOnly)
+    {
+        messages::passwordChangeRequired(
+            asyncResp->res,
+            boost::urls::format("/redfish/v1/AccountService/Accounts/{}",
+                                session->username));
+    }
+
+    crow::getUserInfo(asyncResp, username, session, [asyncResp, session]() {
+        fillSessionObject(asyncResp->res, *session);
+    });
+}
+
 inline void handleSessionCollectionPost(
     crow::App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
@@ -225,41 +270,24 @@ inline void handleSessionCollectionPost(
         return;
     }
 
-    int pamrc = pamAuthenticateUser(username, password);
-    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
-    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
-    {
-        messages::resourceAtUriUnauthorized(asyncResp->res, req.url(),
-                                            "Invalid username or password");
-        return;
-    }
-
-    // User is authenticated - create session
-    std::shared_ptr<persistent_data::UserSession> session =
-        persistent_data::SessionStore::getInstance().generateUserSession(
-            username, req.ipAddress, clientId,
-            persistent_data::PersistenceType::TIMEOUT, isConfigureSelfOnly);
-    if (session == nullptr)
-    {
-        messages::internalError(asyncResp->res);
-        return;
-    }
-
-    asyncResp->res.addHeader("X-Auth-Token", session->sessionToken);
-    asyncResp->res.addHeader(
-        "Location", "/redfish/v1/SessionService/Sessions/" + session->uniqueId);
-    asyncResp->res.result(boost::beast::http::status::created);
-    if (session->isConfigureSelfOnly)
+    // PAM may hash the password with a deliberately slow algorithm, so keep
+    // it off of the main thread
+    bool queued = bmcweb::WorkerPool::getInstance().post(
+        "PamAuthenticate",
+        [username, password]() {
+        return pamAuthenticateUser(username, password);
+    },
+        [asyncResp, username, clientId, url = boost::urls::url(req.url()),
+         ipAddress = req.ipAddress](int pamrc) {
+        afterSessionCollectionPostAuthenticate(asyncResp, username, clientId,
+                                               url, ipAddress, pamrc);
+    });
+    if (!queued)
     {
-        messages::passwordChangeRequired(
+        messages::serviceTemporarilyUnavailable(
             asyncResp->res,
-            boost::urls::format("/redfish/v1/AccountService/Accounts/{}",
-                                session->username));
+            std::to_string(bmcweb::WorkerPool::retryAfter.count()));
     }
-
-    crow::getUserInfo(asyncResp, username, session, [asyncResp, session]() {
-        fillSessionObject(asyncResp->res, *session);
-    });
 }
 inline void handleSessionServiceHead(
     crow::App& app, const crow::Request& req,
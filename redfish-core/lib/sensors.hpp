@@ -22,6 +22,7 @@
 #include "generated/enums/sensor.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
+#include "sensor_cache.hpp"
 #include "str_utility.hpp"
 #include "utils/dbus_utils.hpp"
 #include "utils/json_utils.hpp"
@@ -34,6 +35,7 @@
 
 #include <array>
 #include <cmath>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -2270,6 +2272,27 @@ inline nlohmann::json& getPowerSupply(nlohmann::json& powerSupplyArray,
     return powerSupply;
 }
 
+/**
+ * @brief Gets the objects a service provides under
+ * /xyz/openbmc_project/sensors, from the resident sensor cache when it's
+ * enabled.
+ */
+inline void getSensorObjects(
+    const std::string& connection,
+    std::function<void(const boost::system::error_code&,
+                       const dbus::utility::ManagedObjectType&)>&& callback)
+{
+    if constexpr (BMCWEB_SENSOR_CACHE_TTL != 0)
+    {
+        SensorCache::getInstance().getManagedObjects(connection,
+                                                     std::move(callback));
+        return;
+    }
+    sdbusplus::message::object_path sensorPath("/xyz/openbmc_project/sensors");
+    dbus::utility::getManagedObjects(connection, sensorPath,
+                                     std::move(callback));
+}
+
 /**
  * @brief Gets the values of the specified sensors.
  *
@@ -2305,10 +2328,8 @@ inline void getSensorData(
     // Get managed objects from all services exposing sensors
     for (const std::string& connection : connections)
     {
-        sdbusplus::message::object_path sensorPath(
-            "/xyz/openbmc_project/sensors");
-        dbus::utility::getManagedObjects(
-            connection, sensorPath,
+        getSensorObjects(
+            connection,
             [sensorsAsyncResp, sensorNames,
              inventoryItems](const boost::system::error_code& ec,
                              const dbus::utility::ManagedObjectType& resp) {
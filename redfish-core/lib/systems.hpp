@@ -418,9 +418,22 @@ inline void
     asyncResp->res.jsonValue["AssetTag"] = value;
 }
 
+// The parts of the system inventory a request reads
+struct SystemInventoryParts
+{
+    // MemorySummary
+    bool memory = true;
+    // ProcessorSummary
+    bool processors = true;
+    bool uuid = true;
+    // PartNumber, SerialNumber, Manufacturer, Model, SubModel, AssetTag and
+    // BiosVersion
+    bool asset = true;
+};
+
 inline void afterSystemGetSubTree(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const boost::system::error_code& ec,
+    const SystemInventoryParts& parts, const boost::system::error_code& ec,
     const dbus::utility::MapperGetSubTreeResponse& subtree)
 {
     if (ec)
@@ -450,20 +463,25 @@ inline void afterSystemGetSubTree(
         {
             for (const auto& interfaceName : connection.second)
             {
-                if (interfaceName == "xyz.openbmc_project.Inventory.Item.Dimm")
+                if (interfaceName ==
+                        "xyz.openbmc_project.Inventory.Item.Dimm" &&
+                    parts.memory)
                 {
                     BMCWEB_LOG_DEBUG("Found Dimm, now get its properties.");
 
                     getMemorySummary(asyncResp, connection.first, path);
                 }
                 else if (interfaceName ==
-                         "xyz.openbmc_project.Inventory.Item.Cpu")
+                             "xyz.openbmc_project.Inventory.Item.Cpu" &&
+                         parts.processors)
                 {
                     BMCWEB_LOG_DEBUG("Found Cpu, now get its properties.");
 
                     getProcessorSummary(asyncResp, connection.first, path);
                 }
-                else if (interfaceName == "xyz.openbmc_project.Common.UUID")
+                else if (interfaceName ==
+                             "xyz.openbmc_project.Common.UUID" &&
+                         parts.uuid)
                 {
                     BMCWEB_LOG_DEBUG("Found UUID, now get its properties.");
 
@@ -477,7 +495,8 @@ inline void afterSystemGetSubTree(
                     });
                 }
                 else if (interfaceName ==
-                         "xyz.openbmc_project.Inventory.Item.System")
+                             "xyz.openbmc_project.Inventory.Item.System" &&
+                         parts.asset)
                 {
                     sdbusplus::asio::getAllProperties(
                         *crow::connections::systemBus, connection.first, path,
@@ -504,23 +523,44 @@ inline void afterSystemGetSubTree(
  * @brief Retrieves computer system properties over dbus
  *
  * @param[in] asyncResp Shared pointer for completing asynchronous calls
+ * @param[in] parts     The parts of the inventory to read
  *
  * @return None.
  */
 inline void
-    getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                      const SystemInventoryParts& parts)
 {
     BMCWEB_LOG_DEBUG("Get available system components.");
-    constexpr std::array<std::string_view, 5> interfaces = {
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
-        "xyz.openbmc_project.Inventory.Item.Cpu",
-        "xyz.openbmc_project.Inventory.Item.Dimm",
-        "xyz.openbmc_project.Inventory.Item.System",
-        "xyz.openbmc_project.Common.UUID",
-    };
+    std::vector<std::string_view> interfaces;
+    if (parts.asset)
+    {
+        interfaces.emplace_back(
+            "xyz.openbmc_project.Inventory.Decorator.Asset");
+    }
+    if (parts.processors)
+    {
+        interfaces.emplace_back("xyz.openbmc_project.Inventory.Item.Cpu");
+    }
+    if (parts.memory)
+    {
+        interfaces.emplace_back("xyz.openbmc_project.Inventory.Item.Dimm");
+    }
+    if (parts.asset)
+    {
+        interfaces.emplace_back("xyz.openbmc_project.Inventory.Item.System");
+    }
+    if (parts.uuid)
+    {
+        interfaces.emplace_back("xyz.openbmc_project.Common.UUID");
+    }
+    if (interfaces.empty())
+    {
+        return;
+    }
     dbus::utility::getSubTree(
         "/xyz/openbmc_project/inventory", 0, interfaces,
-        std::bind_front(afterSystemGetSubTree, asyncResp));
+        std::bind_front(afterSystemGetSubTree, asyncResp, parts));
 }
 
 /**
@@ -3030,7 +3070,12 @@ inline void
                             const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                             const std::string& systemName)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::Query delegatedQuery;
+    const query_param::QueryCapabilities capabilities = {
+        .canSkipUnselected = true,
+    };
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -3110,8 +3155,14 @@ inline void
     asyncResp->res.jsonValue["SerialConsole"]["SSH"]["Port"] = 2200;
     asyncResp->res.jsonValue["SerialConsole"]["SSH"]["HotKeySequenceDisplay"] =
         "Press ~. to exit console";
-    getPortStatusAndPath(std::span{protocolToDBusForSystems},
-                         std::bind_front(afterPortRequest, asyncResp));
+
+    // Properties that $select leaves out aren't read at all
+    const query_param::SelectTrie& select = delegatedQuery.selectTrie;
+    if (select.isSelected("SerialConsole"))
+    {
+        getPortStatusAndPath(std::span{protocolToDBusForSystems},
+                             std::bind_front(afterPortRequest, asyncResp));
+    }
 
     if constexpr (BMCWEB_KVM)
     {
@@ -3137,12 +3188,18 @@ inline void
         isMultiHostEnable = true;
     }
 
+    bool hostStateSelected = select.isSelected({"PowerState", "Status"});
     if (isMultiHostEnable)
     {
         //for now enable Host status, TODO need to enable rest of system function
-        getHostState(asyncResp, hostNumber);
+        if (hostStateSelected)
+        {
+            getHostState(asyncResp, hostNumber);
+        }
+        return;
     }
-    else
+
+    if (select.isSelected("Links/Chassis"))
     {
         getMainChassisId(asyncResp,
                          [](const std::string& chassisId,
@@ -3153,28 +3210,90 @@ inline void
                                                        chassisId);
             aRsp->res.jsonValue["Links"]["Chassis"] = std::move(chassisArray);
         });
+    }
 
+    if (select.isSelected("LocationIndicatorActive"))
+    {
         getSystemLocationIndicatorActive(asyncResp);
-        // TODO (Gunnar): Remove IndicatorLED after enough time has passed
+    }
+    // TODO (Gunnar): Remove IndicatorLED after enough time has passed
+    if (select.isSelected("IndicatorLED"))
+    {
         getIndicatorLedState(asyncResp);
-        getComputerSystem(asyncResp);
+    }
+    SystemInventoryParts inventoryParts{
+        .memory = select.isSelected("MemorySummary"),
+        .processors = select.isSelected("ProcessorSummary"),
+        .uuid = select.isSelected("UUID"),
+        .asset = select.isSelected({"PartNumber", "SerialNumber",
+                                    "Manufacturer", "Model", "SubModel",
+                                    "AssetTag", "BiosVersion"}),
+    };
+    getComputerSystem(asyncResp, inventoryParts);
+    if (hostStateSelected)
+    {
         getHostState(asyncResp, 0);
+    }
+    if (select.isSelected(
+            {"Boot/BootSourceOverrideEnabled", "Boot/BootSourceOverrideMode",
+             "Boot/BootSourceOverrideMode@Redfish.AllowableValues",
+             "Boot/BootSourceOverrideTarget",
+             "Boot/BootSourceOverrideTarget@Redfish.AllowableValues"}))
+    {
         getBootProperties(asyncResp);
+    }
+    if (select.isSelected("BootProgress"))
+    {
         getBootProgress(asyncResp);
         getBootProgressLastStateTime(asyncResp);
+    }
+    if (select.isSelected({"PCIeDevices", "PCIeDevices@odata.count"}))
+    {
         pcie_util::getPCIeDeviceList(
             asyncResp, nlohmann::json::json_pointer("/PCIeDevices"));
+    }
+    if (select.isSelected("HostWatchdogTimer"))
+    {
         getHostWatchdogTimer(asyncResp);
+    }
+    if (select.isSelected("PowerRestorePolicy"))
+    {
         getPowerRestorePolicy(asyncResp);
+    }
+    if (select.isSelected("Boot/StopBootOnFault"))
+    {
         getStopBootOnFault(asyncResp);
+    }
+    if (select.isSelected(
+            {"Boot/AutomaticRetryConfig",
+             "Boot/AutomaticRetryConfig@Redfish.AllowableValues",
+             "Boot/AutomaticRetryAttempts",
+             "Boot/RemainingAutomaticRetryAttempts"}))
+    {
         getAutomaticRetryPolicy(asyncResp);
+    }
+    if (select.isSelected("LastResetTime"))
+    {
         getLastResetTime(asyncResp);
-        if constexpr (BMCWEB_REDFISH_PROVISIONING_FEATURE)
+    }
+    if constexpr (BMCWEB_REDFISH_PROVISIONING_FEATURE)
+    {
+        if (select.isSelected("Oem"))
         {
             getProvisioningStatus(asyncResp);
         }
+    }
+    if (select.isSelected("Boot/TrustedModuleRequiredToBoot"))
+    {
         getTrustedModuleRequiredToBoot(asyncResp);
+    }
+    if (select.isSelected(
+            {"PowerMode", "PowerMode@Redfish.AllowableValues"}))
+    {
         getPowerMode(asyncResp);
+    }
+    if (select.isSelected("IdlePowerSaver"))
+    {
         getIdlePowerSaver(asyncResp);
     }
 }
@@ -5,6 +5,16 @@
 #include "logging.hpp"
 #include "utils/time_utils.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
 namespace redfish
 {
 
@@ -82,45 +92,21 @@ struct DateTimeString
     }
 };
 
-// Class that can convert an arbitrary AST type into a structured value
-// Pulling from the json pointer when required
-struct ValueVisitor
-{
-    using result_type = std::variant<std::monostate, double, int64_t,
-                                     std::string, DateTimeString>;
-    nlohmann::json& body;
-    result_type operator()(double n);
-    result_type operator()(int64_t x);
-    result_type operator()(const filter_ast::UnquotedString& x);
-    result_type operator()(const filter_ast::QuotedString& x);
-};
-
-ValueVisitor::result_type ValueVisitor::operator()(double n)
-{
-    return {n};
-}
-
-ValueVisitor::result_type ValueVisitor::operator()(int64_t x)
-{
-    return {x};
-}
-
-ValueVisitor::result_type
-    ValueVisitor::operator()(const filter_ast::QuotedString& x)
+CompiledFilter::DateTime parseDateTime(std::string_view strvalue)
 {
-    return {x};
+    DateTimeString parsed(strvalue);
+    return {parsed.value.count()};
 }
 
-ValueVisitor::result_type
-    ValueVisitor::operator()(const filter_ast::UnquotedString& x)
+// Converts the value of a member's property into something comparable
+CompiledFilter::Value propertyValue(std::string_view property,
+                                    const nlohmann::json* entry)
 {
     // Future, handle paths with / in them
-    nlohmann::json::const_iterator entry = body.find(x);
-    if (entry == body.end())
+    if (entry == nullptr)
     {
         BMCWEB_LOG_ERROR("Key {} doesn't exist in output, cannot filter",
-                         static_cast<std::string>(x));
-        BMCWEB_LOG_DEBUG("Output {}", body.dump());
+                         property);
         return {};
     }
     const double* dValue = entry->get_ptr<const double*>();
@@ -136,43 +122,41 @@ ValueVisitor::result_type
     const std::string* strValue = entry->get_ptr<const std::string*>();
     if (strValue != nullptr)
     {
-        if (DateTimeString::isDateTimeKey(x))
+        if (DateTimeString::isDateTimeKey(property))
         {
-            return DateTimeString(*strValue);
+            return parseDateTime(*strValue);
         }
         return {*strValue};
     }
 
     BMCWEB_LOG_ERROR(
         "Type for key {} was {} which does not have a comparison operator",
-        static_cast<std::string>(x), static_cast<int>(entry->type()));
+        property, static_cast<int>(entry->type()));
     return {};
 }
 
-struct ApplyFilter
+// Converts a literal in the AST into a value
+struct LiteralVisitor
 {
-    nlohmann::json& body;
-    const filter_ast::LogicalAnd& filter;
-    using result_type = bool;
-    bool operator()(const filter_ast::LogicalNot& x);
-    bool operator()(const filter_ast::LogicalOr& x);
-    bool operator()(const filter_ast::LogicalAnd& x);
-    bool operator()(const filter_ast::Comparison& x);
-    bool operator()(const filter_ast::BooleanOp& x);
-
-  public:
-    bool matches();
-};
-
-bool ApplyFilter::operator()(const filter_ast::LogicalNot& x)
-{
-    bool subValue = (*this)(x.operand);
-    if (x.isLogicalNot)
+    using result_type = CompiledFilter::Value;
+    result_type operator()(double n) const
     {
-        return !subValue;
+        return {n};
     }
-    return subValue;
-}
+    result_type operator()(int64_t x) const
+    {
+        return {x};
+    }
+    result_type operator()(const filter_ast::QuotedString& x) const
+    {
+        return {static_cast<const std::string&>(x)};
+    }
+    result_type operator()(const filter_ast::UnquotedString& /*x*/) const
+    {
+        // Properties are never literals
+        return {};
+    }
+};
 
 // Helper function to reduce the number of permutations of a single comparison
 // For all possible types.
@@ -259,14 +243,10 @@ bool doStringComparison(std::string_view left,
     }
 }
 
-bool ApplyFilter::operator()(const filter_ast::Comparison& x)
+bool compareValues(const CompiledFilter::Value& left,
+                   filter_ast::ComparisonOpEnum comparator,
+                   const CompiledFilter::Value& right)
 {
-    ValueVisitor numeric(body);
-    std::variant<std::monostate, double, int64_t, std::string, DateTimeString>
-        left = boost::apply_visitor(numeric, x.left);
-    std::variant<std::monostate, double, int64_t, std::string, DateTimeString>
-        right = boost::apply_visitor(numeric, x.right);
-
     // Numeric comparisons
     const double* lDoubleValue = std::get_if<double>(&left);
     const double* rDoubleValue = std::get_if<double>(&right);
@@ -278,12 +258,13 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
         if (rDoubleValue != nullptr)
         {
             // Both sides are doubles, do the comparison as doubles
-            return doDoubleComparison(*lDoubleValue, x.token, *rDoubleValue);
+            return doDoubleComparison(*lDoubleValue, comparator,
+                                      *rDoubleValue);
         }
         if (rIntValue != nullptr)
         {
             // If right arg is int, promote right arg to double
-            return doDoubleComparison(*lDoubleValue, x.token,
+            return doDoubleComparison(*lDoubleValue, comparator,
                                       static_cast<double>(*rIntValue));
         }
     }
@@ -292,14 +273,14 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
         if (rIntValue != nullptr)
         {
             // Both sides are ints, do the comparison as ints
-            return doIntComparison(*lIntValue, x.token, *rIntValue);
+            return doIntComparison(*lIntValue, comparator, *rIntValue);
         }
 
         if (rDoubleValue != nullptr)
         {
             // Left arg is int, promote left arg to double
-            return doDoubleComparison(static_cast<double>(*lIntValue), x.token,
-                                      *rDoubleValue);
+            return doDoubleComparison(static_cast<double>(*lIntValue),
+                                      comparator, *rDoubleValue);
         }
     }
 
@@ -307,29 +288,34 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
     const std::string* lStrValue = std::get_if<std::string>(&left);
     const std::string* rStrValue = std::get_if<std::string>(&right);
 
-    const DateTimeString* lDateValue = std::get_if<DateTimeString>(&left);
-    const DateTimeString* rDateValue = std::get_if<DateTimeString>(&right);
+    const CompiledFilter::DateTime* lDateValue =
+        std::get_if<CompiledFilter::DateTime>(&left);
+    const CompiledFilter::DateTime* rDateValue =
+        std::get_if<CompiledFilter::DateTime>(&right);
 
-    // If we're trying to compare a date string to a string, construct a
-    // datestring from the string
+    // If we're trying to compare a date string to a string, parse the string
+    // as a date.  Literals compared to a time property were already parsed
+    // when the filter was compiled.
     if (lDateValue != nullptr && rStrValue != nullptr)
     {
-        rDateValue = &right.emplace<DateTimeString>(std::string(*rStrValue));
+        return doIntComparison(lDateValue->usSinceEpoch, comparator,
+                               parseDateTime(*rStrValue).usSinceEpoch);
     }
     if (lStrValue != nullptr && rDateValue != nullptr)
     {
-        lDateValue = &left.emplace<DateTimeString>(std::string(*lStrValue));
+        return doIntComparison(parseDateTime(*lStrValue).usSinceEpoch,
+                               comparator, rDateValue->usSinceEpoch);
     }
 
     if (lDateValue != nullptr && rDateValue != nullptr)
     {
-        return doIntComparison(lDateValue->value.count(), x.token,
-                               rDateValue->value.count());
+        return doIntComparison(lDateValue->usSinceEpoch, comparator,
+                               rDateValue->usSinceEpoch);
     }
 
     if (lStrValue != nullptr && rStrValue != nullptr)
     {
-        return doStringComparison(*lStrValue, x.token, *rStrValue);
+        return doStringComparison(*lStrValue, comparator, *rStrValue);
     }
 
     BMCWEB_LOG_ERROR(
@@ -338,41 +324,206 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
     return true;
 }
 
-bool ApplyFilter::operator()(const filter_ast::BooleanOp& x)
+} // namespace
+
+// Flattens the AST into postfix instructions
+struct CompiledFilter::Compiler
 {
-    return boost::apply_visitor(*this, x);
+    using result_type = void;
+    CompiledFilter& compiled;
+
+    size_t propertyIndex(const std::string& property)
+    {
+        auto it = std::ranges::find(compiled.properties, property);
+        if (it != compiled.properties.end())
+        {
+            return static_cast<size_t>(
+                std::distance(compiled.properties.begin(), it));
+        }
+        compiled.properties.emplace_back(property);
+        return compiled.properties.size() - 1;
+    }
+
+    Operand operand(const filter_ast::Argument& argument,
+                    const filter_ast::Argument& other)
+    {
+        Operand out;
+        const filter_ast::UnquotedString* property =
+            boost::get<filter_ast::UnquotedString>(&argument.get());
+        if (property != nullptr)
+        {
+            out.property = propertyIndex(*property);
+            return out;
+        }
+        LiteralVisitor literal;
+        out.literal = boost::apply_visitor(literal, argument);
+
+        // A string compared to a time property is a time, so is parsed once
+        // here rather than for every member
+        const filter_ast::UnquotedString* otherProperty =
+            boost::get<filter_ast::UnquotedString>(&other.get());
+        const std::string* str = std::get_if<std::string>(&out.literal);
+        if (str != nullptr && otherProperty != nullptr &&
+            DateTimeString::isDateTimeKey(*otherProperty))
+        {
+            out.literal = parseDateTime(*str);
+        }
+        return out;
+    }
+
+    void operator()(const filter_ast::Comparison& x)
+    {
+        Instruction instruction;
+        instruction.op = OpCode::Compare;
+        instruction.comparison = x.token;
+        instruction.left = operand(x.left, x.right);
+        instruction.right = operand(x.right, x.left);
+        compiled.program.emplace_back(std::move(instruction));
+    }
+
+    void operator()(const filter_ast::BooleanOp& x)
+    {
+        boost::apply_visitor(*this, x);
+    }
+
+    void operator()(const filter_ast::LogicalNot& x)
+    {
+        (*this)(x.operand);
+        if (x.isLogicalNot)
+        {
+            compiled.program.emplace_back(Instruction{.op = OpCode::Not});
+        }
+    }
+
+    void operator()(const filter_ast::LogicalOr& x)
+    {
+        (*this)(x.first);
+        for (const filter_ast::LogicalNot& bOp : x.rest)
+        {
+            (*this)(bOp);
+            compiled.program.emplace_back(Instruction{.op = OpCode::Or});
+        }
+    }
+
+    void operator()(const filter_ast::LogicalAnd& x)
+    {
+        (*this)(x.first);
+        for (const filter_ast::LogicalOr& bOp : x.rest)
+        {
+            (*this)(bOp);
+            compiled.program.emplace_back(Instruction{.op = OpCode::And});
+        }
+    }
+};
+
+CompiledFilter::CompiledFilter(const filter_ast::LogicalAnd& filter)
+{
+    Compiler compiler{*this};
+    compiler(filter);
 }
 
-bool ApplyFilter::operator()(const filter_ast::LogicalOr& x)
+std::vector<uint8_t>
+    CompiledFilter::run(const std::vector<std::vector<Value>>& columns,
+                        size_t count) const
 {
-    bool value = (*this)(x.first);
-    for (const filter_ast::LogicalNot& bOp : x.rest)
+    // Each entry holds the result of an instruction for every member
+    std::vector<std::vector<uint8_t>> stack;
+    for (const Instruction& instruction : program)
+    {
+        if (instruction.op == OpCode::Compare)
+        {
+            // A literal is the same for every member, so is stepped over
+            // with a stride of zero
+            const Value* left = &instruction.left.literal;
+            size_t leftStride = 0;
+            if (instruction.left.property)
+            {
+                left = columns[*instruction.left.property].data();
+                leftStride = 1;
+            }
+            const Value* right = &instruction.right.literal;
+            size_t rightStride = 0;
+            if (instruction.right.property)
+            {
+                right = columns[*instruction.right.property].data();
+                rightStride = 1;
+            }
+            std::vector<uint8_t>& result = stack.emplace_back(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                result[i] = static_cast<uint8_t>(
+                    compareValues(left[i * leftStride],
+                                  instruction.comparison,
+                                  right[i * rightStride]));
+            }
+            continue;
+        }
+        if (instruction.op == OpCode::Not)
+        {
+            for (uint8_t& value : stack.back())
+            {
+                value = static_cast<uint8_t>(value == 0U);
+            }
+            continue;
+        }
+        std::vector<uint8_t> operand = std::move(stack.back());
+        stack.pop_back();
+        std::vector<uint8_t>& result = stack.back();
+        for (size_t i = 0; i < count; i++)
+        {
+            if (instruction.op == OpCode::And)
+            {
+                result[i] &= operand[i];
+            }
+            else
+            {
+                result[i] |= operand[i];
+            }
+        }
+    }
+    if (stack.size() != 1)
     {
-        value = value || (*this)(bOp);
+        BMCWEB_LOG_ERROR("Filter program left {} results", stack.size());
+        return std::vector<uint8_t>(count, 0);
     }
-    return value;
+    return std::move(stack.back());
 }
 
-bool ApplyFilter::operator()(const filter_ast::LogicalAnd& x)
+// Evaluates the filter against a single member
+bool CompiledFilter::matches(const FilterPropertyLookup& lookup) const
 {
-    bool value = (*this)(x.first);
-    for (const filter_ast::LogicalOr& bOp : x.rest)
+    std::vector<std::vector<Value>> columns(properties.size());
+    for (size_t i = 0; i < properties.size(); i++)
     {
-        value = value && (*this)(bOp);
+        columns[i].emplace_back(
+            propertyValue(properties[i], lookup(properties[i])));
     }
-    return value;
+    return run(columns, 1).front() != 0U;
 }
 
-bool ApplyFilter::matches()
+std::vector<uint8_t>
+    CompiledFilter::matches(const nlohmann::json::array_t& members) const
 {
-    return (*this)(filter);
+    std::vector<std::vector<Value>> columns(properties.size());
+    for (size_t i = 0; i < properties.size(); i++)
+    {
+        columns[i].reserve(members.size());
+        for (const nlohmann::json& member : members)
+        {
+            const nlohmann::json* entry = nullptr;
+            nlohmann::json::const_iterator it = member.find(properties[i]);
+            if (it != member.end())
+            {
+                entry = &*it;
+            }
+            columns[i].emplace_back(propertyValue(properties[i], entry));
+        }
+    }
+    return run(columns, members.size());
 }
 
-} // namespace
-
 // Applies a filter expression to a member array
-bool applyFilter(nlohmann::json& body,
-                 const filter_ast::LogicalAnd& filterParam)
+bool applyFilter(nlohmann::json& body, const CompiledFilter& filter)
 {
     using nlohmann::json;
 
@@ -395,22 +546,33 @@ bool applyFilter(nlohmann::json& body,
         return false;
     }
 
-    json::array_t::iterator it = memberArr->begin();
-    size_t index = 0;
-    while (it != memberArr->end())
+    std::vector<uint8_t> matched = filter.matches(*memberArr);
+    json::array_t passed;
+    passed.reserve(memberArr->size());
+    for (size_t index = 0; index < memberArr->size(); index++)
     {
-        ApplyFilter filterApplier(*it, filterParam);
-        if (!filterApplier.matches())
+        if (matched[index] == 0U)
         {
             BMCWEB_LOG_DEBUG("Removing item at index {}", index);
-            it = memberArr->erase(it);
-            index++;
             continue;
         }
-        it++;
-        index++;
+        passed.emplace_back(std::move((*memberArr)[index]));
+    }
+    *memberArr = std::move(passed);
+
+    // The count is of the members that passed
+    json::object_t::iterator count = obj->find("Members@odata.count");
+    if (count != obj->end())
+    {
+        count->second = memberArr->size();
     }
 
     return true;
 }
+
+bool applyFilter(nlohmann::json& body,
+                 const filter_ast::LogicalAnd& filterParam)
+{
+    return applyFilter(body, CompiledFilter(filterParam));
+}
 } // namespace redfish
@@ -5,6 +5,7 @@
 #include "app.hpp"
 #include "dbus_monitor.hpp"
 #include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
 #include "event_service_manager.hpp"
 #include "google/google_service_root.hpp"
 #include "hostname_monitor.hpp"
@@ -21,6 +22,7 @@
 #include "vm_websocket.hpp"
 #include "vm1_websocket.hpp"
 #include "webassets.hpp"
+#include "worker_pool.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <sdbusplus/asio/connection.hpp>
@@ -35,6 +37,9 @@ int run()
     sdbusplus::asio::connection systemBus(*io);
     crow::connections::systemBus = &systemBus;
 
+    // Create WorkerPool instance, starting its threads if configured
+    bmcweb::WorkerPool::getInstance(&*io);
+
     // Static assets need to be initialized before Authorization, because auth
     // needs to build the whitelist from the static routes
 
@@ -106,10 +111,14 @@ int run()
     }
 
     bmcweb::registerUserRemovedSignal();
+    bmcweb::registerUserChangedSignal();
+    dbus::utility::registerMapperCacheInvalidation();
 
     app.run();
     io->run();
 
+    bmcweb::WorkerPool::getInstance().stop();
+
     crow::connections::systemBus = nullptr;
 
     return 0;
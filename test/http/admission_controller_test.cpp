@@ -0,0 +1,126 @@
+#include "http/admission_controller.hpp"
+
+#include <boost/asio/ip/address.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+using Decision = AdmissionController::Decision;
+
+const boost::asio::ip::address clientA =
+    boost::asio::ip::make_address("10.0.0.1");
+const boost::asio::ip::address clientB =
+    boost::asio::ip::make_address("10.0.0.2");
+
+TEST(AdmissionController, AdmitsUpToMaxConnections)
+{
+    AdmissionController controller(AdmissionLimits{
+        .maxConnections = 2,
+        .maxPerClient = 0,
+        .maxQueued = 0,
+        .maxRejecting = 1,
+    });
+    uint64_t ticket = 0;
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+    EXPECT_EQ(controller.admit(clientB, ticket, []() {}), Decision::Admit);
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Reject);
+    // Only one rejection may be in flight
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Drop);
+
+    controller.rejectDone();
+    controller.release(clientA);
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+
+    AdmissionMetrics metrics = controller.getMetrics();
+    EXPECT_EQ(metrics.active, 2U);
+    EXPECT_EQ(metrics.admitted, 3U);
+    EXPECT_EQ(metrics.rejectedFull, 2U);
+    EXPECT_EQ(metrics.dropped, 1U);
+}
+
+TEST(AdmissionController, LimitsEachClient)
+{
+    AdmissionController controller(AdmissionLimits{
+        .maxConnections = 10,
+        .maxPerClient = 1,
+        .maxQueued = 0,
+        .maxRejecting = 4,
+    });
+    uint64_t ticket = 0;
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Reject);
+    EXPECT_EQ(controller.admit(clientB, ticket, []() {}), Decision::Admit);
+
+    controller.release(clientA);
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+    EXPECT_EQ(controller.getMetrics().rejectedPerClient, 1U);
+}
+
+TEST(AdmissionController, QueuedConnectionTakesFreedSlot)
+{
+    AdmissionController controller(AdmissionLimits{
+        .maxConnections = 1,
+        .maxPerClient = 0,
+        .maxQueued = 1,
+        .maxRejecting = 4,
+    });
+    uint64_t ticket = 0;
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+
+    bool admitted = false;
+    uint64_t queuedTicket = 0;
+    EXPECT_EQ(controller.admit(clientB, queuedTicket,
+                               [&admitted]() { admitted = true; }),
+              Decision::Queue);
+    // The queue is full
+    EXPECT_EQ(controller.admit(clientB, ticket, []() {}), Decision::Reject);
+    EXPECT_EQ(controller.getMetrics().queued, 1U);
+
+    controller.release(clientA);
+    EXPECT_TRUE(admitted);
+    // Too late to cancel, the connection was already admitted
+    EXPECT_EQ(controller.cancel(queuedTicket), Decision::Admit);
+
+    AdmissionMetrics metrics = controller.getMetrics();
+    EXPECT_EQ(metrics.active, 1U);
+    EXPECT_EQ(metrics.queued, 0U);
+    EXPECT_EQ(metrics.admittedFromQueue, 1U);
+}
+
+TEST(AdmissionController, QueuedConnectionTimesOut)
+{
+    AdmissionController controller(AdmissionLimits{
+        .maxConnections = 1,
+        .maxPerClient = 1,
+        .maxQueued = 1,
+        .maxRejecting = 4,
+    });
+    uint64_t ticket = 0;
+    EXPECT_EQ(controller.admit(clientA, ticket, []() {}), Decision::Admit);
+
+    bool admitted = false;
+    uint64_t queuedTicket = 0;
+    EXPECT_EQ(controller.admit(clientB, queuedTicket,
+                               [&admitted]() { admitted = true; }),
+              Decision::Queue);
+    // Queued connections count against their client's limit
+    EXPECT_EQ(controller.admit(clientB, ticket, []() {}), Decision::Reject);
+
+    EXPECT_EQ(controller.cancel(queuedTicket), Decision::Reject);
+    controller.release(clientA);
+    EXPECT_FALSE(admitted);
+
+    AdmissionMetrics metrics = controller.getMetrics();
+    EXPECT_EQ(metrics.active, 0U);
+    EXPECT_EQ(metrics.queueTimeouts, 1U);
+    EXPECT_EQ(controller.admit(clientB, ticket, []() {}), Decision::Admit);
+}
+
+} // namespace
+} // namespace crow
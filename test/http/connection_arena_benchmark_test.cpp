@@ -0,0 +1,167 @@
+#include "async_resp.hpp"
+#include "http/connection_arena.hpp"
+#include "http/http_connection.hpp"
+#include "http/http_request.hpp"
+#include "http/http_response.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/_experimental/test/stream.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+size_t allocationCount = 0;
+} // namespace
+
+// Count every allocation made by this test binary
+void* operator new(size_t size)
+{
+    allocationCount++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace crow
+{
+namespace
+{
+
+// Stands in for the D-Bus backed handler, producing a body shaped like the
+// response to /redfish/v1/Systems/system
+struct SystemHandler
+{
+    static void
+        handleUpgrade(const std::shared_ptr<Request>& /*req*/,
+                      const std::shared_ptr<bmcweb::AsyncResp>& /*asyncResp*/,
+                      boost::beast::test::stream&& /*adaptor*/)
+    {
+        EXPECT_FALSE(true);
+    }
+
+    void handle(const std::shared_ptr<Request>& /*req*/,
+                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        nlohmann::json& json = asyncResp->res.jsonValue;
+        json["@odata.type"] = "#ComputerSystem.v1_22_0.ComputerSystem";
+        json["@odata.id"] = "/redfish/v1/Systems/system";
+        json["Id"] = "system";
+        json["Name"] = "system";
+        json["SystemType"] = "Physical";
+        json["PowerState"] = "On";
+        json["Status"]["State"] = "Enabled";
+        json["Status"]["Health"] = "OK";
+        json["ProcessorSummary"]["Count"] = 2;
+        json["MemorySummary"]["TotalSystemMemoryGiB"] = 64;
+        json["Boot"]["BootSourceOverrideEnabled"] = "Disabled";
+        json["Boot"]["BootSourceOverrideTarget"] = "None";
+        json["Processors"]["@odata.id"] =
+            "/redfish/v1/Systems/system/Processors";
+        json["Memory"]["@odata.id"] = "/redfish/v1/Systems/system/Memory";
+        json["LogServices"]["@odata.id"] =
+            "/redfish/v1/Systems/system/LogServices";
+        json["Links"]["Chassis"] = nlohmann::json::array(
+            {{{"@odata.id", "/redfish/v1/Chassis/chassis"}}});
+        json["Links"]["ManagedBy"] = nlohmann::json::array(
+            {{{"@odata.id", "/redfish/v1/Managers/bmc"}}});
+        json["Actions"]["#ComputerSystem.Reset"]["target"] =
+            "/redfish/v1/Systems/system/Actions/ComputerSystem.Reset";
+        handled++;
+    }
+
+    size_t handled = 0;
+};
+
+TEST(ConnectionArenaBenchmark, AllocationsPerSystemGet)
+{
+    constexpr size_t requests = 100;
+
+    boost::asio::io_context io;
+    boost::beast::test::stream stream(io);
+    boost::beast::test::stream out(io);
+    stream.connect(out);
+
+    SystemHandler handler;
+    std::function<std::string()> date([]() { return "TestTime"; });
+    auto conn = std::make_shared<
+        crow::Connection<boost::beast::test::stream, SystemHandler>>(
+        &handler, boost::asio::steady_timer(io), date, std::move(stream),
+        io.get_executor());
+    conn->start();
+
+    auto sendGet = [&out, &io]() {
+        out.write_some(boost::asio::buffer(
+            "GET /redfish/v1/Systems/system HTTP/1.1\r\n"
+            "Host: openbmc_project.xyz\r\n\r\n"));
+        io.restart();
+        while (io.poll() != 0)
+        {}
+        out.clear();
+    };
+
+    // The first request fills the arena's pools
+    sendGet();
+    ASSERT_EQ(handler.handled, 1U);
+
+    size_t before = allocationCount;
+    for (size_t i = 0; i < requests; i++)
+    {
+        sendGet();
+    }
+    size_t perRequest = (allocationCount - before) / requests;
+    ASSERT_EQ(handler.handled, requests + 1);
+
+    // Compare with what allocating the per request objects from the heap
+    // would have cost
+    before = allocationCount;
+    for (size_t i = 0; i < requests; i++)
+    {
+        std::make_shared<bmcweb::AsyncResp>();
+    }
+    size_t heapAsyncResp = (allocationCount - before) / requests;
+
+    bmcweb::ConnectionArena arena;
+    arena.makeShared<bmcweb::AsyncResp>();
+    before = allocationCount;
+    for (size_t i = 0; i < requests; i++)
+    {
+        arena.makeShared<bmcweb::AsyncResp>();
+    }
+    size_t arenaAsyncResp = (allocationCount - before) / requests;
+
+    RecordProperty("allocationsPerRequest", std::to_string(perRequest));
+    RecordProperty("heapAllocationsPerAsyncResp",
+                   std::to_string(heapAsyncResp));
+    RecordProperty("arenaAllocationsPerAsyncResp",
+                   std::to_string(arenaAsyncResp));
+    EXPECT_LT(arenaAsyncResp, heapAsyncResp);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,72 @@
+#include "async_resp.hpp"
+#include "http/connection_arena.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+size_t allocationCount = 0;
+} // namespace
+
+// Count every allocation made by this test binary
+void* operator new(size_t size)
+{
+    allocationCount++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace crow
+{
+namespace
+{
+
+TEST(ConnectionArena, ReusesFreedBlocks)
+{
+    bmcweb::ConnectionArena arena;
+    const void* first = nullptr;
+    {
+        std::shared_ptr<bmcweb::AsyncResp> asyncResp =
+            arena.makeShared<bmcweb::AsyncResp>();
+        first = asyncResp.get();
+    }
+    size_t before = allocationCount;
+    std::shared_ptr<bmcweb::AsyncResp> asyncResp =
+        arena.makeShared<bmcweb::AsyncResp>();
+    EXPECT_EQ(asyncResp.get(), first);
+    EXPECT_EQ(allocationCount, before);
+}
+
+TEST(ConnectionArena, ObjectsOutliveArena)
+{
+    std::shared_ptr<std::string> str;
+    {
+        bmcweb::ConnectionArena arena;
+        str = arena.makeShared<std::string>("outlives the arena");
+    }
+    EXPECT_EQ(*str, "outlives the arena");
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,106 @@
+#include "http/content_encoding.hpp"
+
+#include <zlib.h>
+
+#include <bit>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+std::string decompress(std::string_view in, ContentEncoding encoding)
+{
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream,
+                           encoding == ContentEncoding::Gzip ? 15 + 16 : 15),
+              Z_OK);
+    stream.next_in = std::bit_cast<Bytef*>(in.data());
+    stream.avail_in = static_cast<uInt>(in.size());
+    std::string out;
+    int ret = Z_OK;
+    while (ret == Z_OK)
+    {
+        size_t used = out.size();
+        out.resize(used + 4096);
+        stream.next_out = std::bit_cast<Bytef*>(&out[used]);
+        stream.avail_out = 4096;
+        ret = inflate(&stream, Z_NO_FLUSH);
+        out.resize(used + 4096 - stream.avail_out);
+    }
+    EXPECT_EQ(ret, Z_STREAM_END);
+    inflateEnd(&stream);
+    return out;
+}
+
+TEST(getPreferredContentEncoding, NoneAcceptable)
+{
+    EXPECT_EQ(getPreferredContentEncoding(""), ContentEncoding::Identity);
+    EXPECT_EQ(getPreferredContentEncoding("identity"),
+              ContentEncoding::Identity);
+    EXPECT_EQ(getPreferredContentEncoding("br, zstd"),
+              ContentEncoding::Identity);
+    EXPECT_EQ(getPreferredContentEncoding("gzip;q=0, deflate;q=0.000"),
+              ContentEncoding::Identity);
+    EXPECT_EQ(getPreferredContentEncoding("*;q=0"), ContentEncoding::Identity);
+}
+
+TEST(getPreferredContentEncoding, PrefersGzip)
+{
+    EXPECT_EQ(getPreferredContentEncoding("gzip"), ContentEncoding::Gzip);
+    EXPECT_EQ(getPreferredContentEncoding("deflate, gzip;q=0.5, br"),
+              ContentEncoding::Gzip);
+    EXPECT_EQ(getPreferredContentEncoding("*"), ContentEncoding::Gzip);
+}
+
+TEST(getPreferredContentEncoding, Deflate)
+{
+    EXPECT_EQ(getPreferredContentEncoding("deflate"), ContentEncoding::Deflate);
+    EXPECT_EQ(getPreferredContentEncoding("gzip;q=0, deflate"),
+              ContentEncoding::Deflate);
+    // Explicitly refusing gzip overrides the wildcard
+    EXPECT_EQ(getPreferredContentEncoding("gzip;q=0, *"),
+              ContentEncoding::Deflate);
+}
+
+TEST(ContentEncoder, RoundTrip)
+{
+    std::string data;
+    while (data.size() < 200000)
+    {
+        data += R"({"@odata.id": "/redfish/v1/Chassis/chassis/Sensors"},)";
+    }
+    for (ContentEncoding encoding :
+         {ContentEncoding::Gzip, ContentEncoding::Deflate})
+    {
+        ContentEncoder encoder;
+        ASSERT_TRUE(encoder.init(encoding, 1));
+        std::string out;
+        std::string_view in(data);
+        while (in.size() > 7000)
+        {
+            ASSERT_TRUE(encoder.compress(in.substr(0, 7000), false, out));
+            in.remove_prefix(7000);
+        }
+        ASSERT_TRUE(encoder.compress(in, true, out));
+        EXPECT_LT(out.size(), data.size() / 8);
+        EXPECT_EQ(decompress(out, encoding), data);
+    }
+}
+
+TEST(ContentEncoder, Empty)
+{
+    ContentEncoder encoder;
+    ASSERT_TRUE(encoder.init(ContentEncoding::Gzip, 1));
+    std::string out;
+    ASSERT_TRUE(encoder.compress("", true, out));
+    EXPECT_EQ(decompress(out, ContentEncoding::Gzip), "");
+}
+
+} // namespace
+} // namespace bmcweb
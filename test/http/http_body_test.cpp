@@ -2,11 +2,13 @@
 #include "http_body.hpp"
 
 #include <boost/beast/core/file_base.hpp>
+#include <boost/beast/http/message.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <array>
 #include <cstddef>
 #include <cstdio>
+#include <memory>
 #include <span>
 #include <string>
 #include <utility>
@@ -64,6 +66,30 @@ TEST(HttpHttpBodyValueType, CopyOperatorString)
     EXPECT_EQ(value2.payloadSize(), 10);
 }
 
+TEST(HttpHttpBodyValueType, SharedString)
+{
+    auto shared = std::make_shared<const std::string>("teststring");
+    boost::beast::http::request<HttpBody> req;
+    req.body().setShared(shared);
+    EXPECT_EQ(req.body().payloadSize(), 10);
+
+    // Copies send the very same string
+    HttpBody::value_type copy = req.body();
+    EXPECT_EQ(&copy.payload(), shared.get());
+
+    boost::beast::error_code ec;
+    HttpBody::writer writer(req.base(), req.body());
+    auto out = writer.get(ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(out);
+    EXPECT_EQ(out->first.data(), shared->data());
+    EXPECT_EQ(out->first.size(), 10U);
+    EXPECT_FALSE(out->second);
+
+    req.body().clear();
+    EXPECT_EQ(req.body().payloadSize(), 0);
+}
+
 TEST(HttpHttpBodyValueType, MoveFile)
 {
     HttpBody::value_type value(EncodingType::Base64);
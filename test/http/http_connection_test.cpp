@@ -5,6 +5,7 @@
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/_experimental/test/stream.hpp>
 #include <boost/beast/http/field.hpp>
@@ -15,6 +16,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 namespace crow
@@ -74,7 +76,8 @@ TEST(http_connection, RequestPropogates)
     std::shared_ptr<crow::Connection<boost::beast::test::stream, FakeHandler>>
         conn = std::make_shared<
             crow::Connection<boost::beast::test::stream, FakeHandler>>(
-            &handler, std::move(timer), date, std::move(stream));
+            &handler, std::move(timer), date, std::move(stream),
+            io.get_executor());
     conn->start();
     io.run_for(std::chrono::seconds(1000));
     EXPECT_TRUE(handler.called);
@@ -93,4 +96,105 @@ TEST(http_connection, RequestPropogates)
     EXPECT_TRUE(clock.wascalled);
 }
 
+TEST(http_connection, RequestPropogatesToMainExecutor)
+{
+    // The socket belongs to the connection's own io_context, while the
+    // handlers run on another, as with http-io-threads
+    boost::asio::io_context io;
+    boost::asio::io_context connectionIo;
+    ClockFake clock;
+    boost::beast::test::stream stream(connectionIo);
+    boost::beast::test::stream out(connectionIo);
+    stream.connect(out);
+
+    out.write_some(boost::asio::buffer(
+        "GET / HTTP/1.1\r\nHost: openbmc_project.xyz\r\nConnection: close\r\n\r\n"));
+    FakeHandler handler;
+    boost::asio::steady_timer timer(connectionIo);
+    std::function<std::string()> date(
+        std::bind_front(&ClockFake::getDateStr, &clock));
+    std::shared_ptr<crow::Connection<boost::beast::test::stream, FakeHandler>>
+        conn = std::make_shared<
+            crow::Connection<boost::beast::test::stream, FakeHandler>>(
+            &handler, std::move(timer), date, std::move(stream),
+            io.get_executor());
+    EXPECT_EQ(conn->getExecutor(), connectionIo.get_executor());
+    boost::asio::post(conn->getExecutor(), [conn] { conn->start(); });
+    conn = nullptr;
+    while (io.poll() + connectionIo.poll() != 0)
+    {}
+    EXPECT_TRUE(handler.called);
+    EXPECT_TRUE(clock.wascalled);
+    EXPECT_TRUE(out.str().starts_with("HTTP/1.1 200 OK\r\n"));
+}
+
+// Holds on to the response for /slow until told to complete it
+struct PipelineHandler
+{
+    static void
+        handleUpgrade(const std::shared_ptr<Request>& /*req*/,
+                      const std::shared_ptr<bmcweb::AsyncResp>& /*asyncResp*/,
+                      boost::beast::test::stream&& /*adaptor*/)
+    {
+        EXPECT_FALSE(true);
+    }
+
+    void handle(const std::shared_ptr<Request>& req,
+                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        targets.emplace_back(req->target());
+        asyncResp->res.write(std::string(req->target()));
+        if (req->target() == "/slow")
+        {
+            slow = asyncResp;
+        }
+    }
+
+    std::vector<std::string> targets;
+    std::shared_ptr<bmcweb::AsyncResp> slow;
+};
+
+TEST(http_connection, PipelinedRequestsAnsweredInOrder)
+{
+    boost::asio::io_context io;
+    ClockFake clock;
+    boost::beast::test::stream stream(io);
+    boost::beast::test::stream out(io);
+    stream.connect(out);
+
+    out.write_some(boost::asio::buffer(
+        "GET /slow HTTP/1.1\r\nHost: openbmc_project.xyz\r\n\r\n"
+        "GET /fast HTTP/1.1\r\nHost: openbmc_project.xyz\r\n"
+        "Connection: close\r\n\r\n"));
+    PipelineHandler handler;
+    boost::asio::steady_timer timer(io);
+    std::function<std::string()> date(
+        std::bind_front(&ClockFake::getDateStr, &clock));
+    auto conn = std::make_shared<
+        crow::Connection<boost::beast::test::stream, PipelineHandler>>(
+        &handler, std::move(timer), date, std::move(stream),
+        io.get_executor());
+    conn->start();
+    conn = nullptr;
+    while (io.poll() != 0)
+    {}
+
+    // The second request has been read, but waits for the first response
+    ASSERT_EQ(handler.targets, std::vector<std::string>{"/slow"});
+    EXPECT_EQ(out.str(), "");
+
+    handler.slow = nullptr;
+    io.restart();
+    while (io.poll() != 0)
+    {}
+
+    EXPECT_EQ(handler.targets, (std::vector<std::string>{"/slow", "/fast"}));
+    std::string outStr = out.str();
+    size_t slowPos = outStr.find("\r\n\r\n/slow");
+    size_t fastPos = outStr.find("\r\n\r\n/fast");
+    ASSERT_NE(slowPos, std::string::npos);
+    ASSERT_NE(fastPos, std::string::npos);
+    EXPECT_LT(slowPos, fastPos);
+}
+
 } // namespace crow
@@ -1,4 +1,5 @@
 #include "file_test_utilities.hpp"
+#include "http/content_encoding.hpp"
 #include "http/http_body.hpp"
 #include "http/http_response.hpp"
 #include "utility.hpp"
@@ -9,7 +10,11 @@
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
 
+#include <zlib.h>
+
+#include <bit>
 #include <cstdio>
 #include <filesystem>
 #include <string>
@@ -182,4 +187,111 @@ TEST(HttpResponse, HttpBodyWriterLarge)
     EXPECT_EQ(getData(res.response), data);
 }
 
+nlohmann::json generateBigJson()
+{
+    nlohmann::json ret;
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < 5000; i++)
+    {
+        nlohmann::json::object_t member;
+        member["@odata.id"] = "/redfish/v1/Entries/" + std::to_string(i);
+        member["Message"] = "sample text";
+        members.emplace_back(std::move(member));
+    }
+    ret["Members"] = std::move(members);
+    return ret;
+}
+
+TEST(HttpResponse, JsonBodySmall)
+{
+    crow::Response res;
+    res.jsonValue["Name"] = "sample text";
+    std::string expected = res.jsonValue.dump(
+        2, ' ', true, nlohmann::json::error_handler_t::replace);
+    res.writeJson(2, true);
+    EXPECT_EQ(*res.body(), expected);
+    EXPECT_EQ(res.size(), expected.size());
+}
+
+TEST(HttpResponse, JsonBodyWriterLarge)
+{
+    crow::Response res;
+    res.jsonValue = generateBigJson();
+    std::string expected = res.jsonValue.dump(
+        2, ' ', true, nlohmann::json::error_handler_t::replace);
+    res.writeJson(2, true);
+    // Large bodies are streamed, so the length isn't known up front
+    EXPECT_EQ(res.size(), std::nullopt);
+    EXPECT_EQ(getData(res.response), expected);
+}
+
+TEST(HttpResponse, JsonBodyWriterLargeNoStreaming)
+{
+    crow::Response res;
+    res.jsonValue = generateBigJson();
+    std::string expected = res.jsonValue.dump(
+        2, ' ', true, nlohmann::json::error_handler_t::replace);
+    res.writeJson(2, false);
+    EXPECT_EQ(res.size(), expected.size());
+    EXPECT_EQ(*res.body(), expected);
+}
+
+std::string gunzip(std::string_view in)
+{
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    stream.next_in = std::bit_cast<Bytef*>(in.data());
+    stream.avail_in = static_cast<uInt>(in.size());
+    std::string out;
+    int ret = Z_OK;
+    while (ret == Z_OK)
+    {
+        size_t used = out.size();
+        out.resize(used + 4096);
+        stream.next_out = std::bit_cast<Bytef*>(&out[used]);
+        stream.avail_out = 4096;
+        ret = inflate(&stream, Z_NO_FLUSH);
+        out.resize(used + 4096 - stream.avail_out);
+    }
+    EXPECT_EQ(ret, Z_STREAM_END);
+    inflateEnd(&stream);
+    return out;
+}
+
+TEST(HttpResponse, GzipStringBodyWriter)
+{
+    crow::Response res;
+    std::string data = generateBigdata();
+    res.write(std::string(data));
+    res.setContentEncoding(bmcweb::ContentEncoding::Gzip);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::content_encoding),
+              "gzip");
+    // Compressed length isn't known until the body has been written
+    EXPECT_EQ(res.size(), std::nullopt);
+    std::string body = getData(res.response);
+    EXPECT_LT(body.size(), data.size());
+    EXPECT_EQ(gunzip(body), data);
+}
+
+TEST(HttpResponse, GzipHttpBodyWriter)
+{
+    crow::Response res;
+    std::string data = generateBigdata();
+    TemporaryFileHandle temporaryFile(data);
+    res.openFile(temporaryFile.stringPath);
+    res.setContentEncoding(bmcweb::ContentEncoding::Gzip);
+    EXPECT_EQ(gunzip(getData(res.response)), data);
+}
+
+TEST(HttpResponse, GzipJsonBodyWriterLarge)
+{
+    crow::Response res;
+    res.jsonValue = generateBigJson();
+    std::string expected = res.jsonValue.dump(
+        2, ' ', true, nlohmann::json::error_handler_t::replace);
+    res.writeJson(2, true);
+    res.setContentEncoding(bmcweb::ContentEncoding::Gzip);
+    EXPECT_EQ(gunzip(getData(res.response)), expected);
+}
+
 } // namespace
@@ -0,0 +1,99 @@
+#include "http/json_stream_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+std::string streamAll(const nlohmann::json& json, int indent, size_t chunkSize)
+{
+    JsonStreamSerializer serializer(nlohmann::json(json), indent);
+    std::string out;
+    while (true)
+    {
+        serializer.fill(chunkSize);
+        std::string_view pending = serializer.pending();
+        std::string_view chunk = pending.substr(0, chunkSize);
+        out += chunk;
+        serializer.consume(chunk.size());
+        if (serializer.isSerialized() && serializer.pending().empty())
+        {
+            break;
+        }
+    }
+    return out;
+}
+
+// Approximates a SensorCollection with $expand, one of the larger payloads
+// bmcweb commonly returns
+nlohmann::json generateSensorCollection()
+{
+    nlohmann::json ret;
+    ret["@odata.id"] = "/redfish/v1/Chassis/chassis/Sensors";
+    ret["@odata.type"] = "#SensorCollection.SensorCollection";
+    ret["Name"] = "Sensors";
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        std::string id = "temperature_" + std::to_string(i);
+        nlohmann::json::object_t sensor;
+        sensor["@odata.id"] = "/redfish/v1/Chassis/chassis/Sensors/" + id;
+        sensor["@odata.type"] = "#Sensor.v1_2_0.Sensor";
+        sensor["Id"] = id;
+        sensor["Name"] = id;
+        sensor["Reading"] = 40.5;
+        sensor["ReadingType"] = "Temperature";
+        sensor["ReadingUnits"] = "Cel";
+        sensor["Status"] = {{"Health", "OK"}, {"State", "Enabled"}};
+        sensor["Thresholds"] = {
+            {"UpperCaution", {{"Reading", 80.0}}},
+            {"UpperCritical", {{"Reading", 95.0}}},
+        };
+        members.emplace_back(std::move(sensor));
+    }
+    ret["Members@odata.count"] = members.size();
+    ret["Members"] = std::move(members);
+    return ret;
+}
+
+TEST(JsonStreamSerializerBenchmark, CompactComparedToIndented)
+{
+    nlohmann::json json = generateSensorCollection();
+
+    auto start = std::chrono::steady_clock::now();
+    std::string indented = streamAll(json, 2, 4096);
+    auto indentedTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::string compact = streamAll(json, -1, 4096);
+    auto compactTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(nlohmann::json::parse(compact), json);
+    // Whitespace makes up well over 20% of an indented collection
+    EXPECT_LT(compact.size() * 10, indented.size() * 8);
+
+    RecordProperty("IndentedBytes", std::to_string(indented.size()));
+    RecordProperty("CompactBytes", std::to_string(compact.size()));
+    RecordProperty(
+        "IndentedMicroseconds",
+        std::to_string(
+            std::chrono::duration_cast<std::chrono::microseconds>(indentedTime)
+                .count()));
+    RecordProperty(
+        "CompactMicroseconds",
+        std::to_string(
+            std::chrono::duration_cast<std::chrono::microseconds>(compactTime)
+                .count()));
+}
+
+} // namespace
+} // namespace bmcweb
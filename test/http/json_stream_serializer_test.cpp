@@ -0,0 +1,152 @@
+#include "http/json_stream_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+std::string streamAll(const nlohmann::json& json, int indent, size_t chunkSize)
+{
+    JsonStreamSerializer serializer(nlohmann::json(json), indent);
+    std::string out;
+    while (true)
+    {
+        serializer.fill(chunkSize);
+        std::string_view pending = serializer.pending();
+        std::string_view chunk = pending.substr(0, chunkSize);
+        out += chunk;
+        serializer.consume(chunk.size());
+        if (serializer.isSerialized() && serializer.pending().empty())
+        {
+            break;
+        }
+    }
+    return out;
+}
+
+void expectMatchesDump(const nlohmann::json& json)
+{
+    for (int indent : {-1, 0, 2})
+    {
+        std::string expected = json.dump(
+            indent, ' ', true, nlohmann::json::error_handler_t::replace);
+        for (size_t chunkSize : {1U, 7U, 4096U})
+        {
+            EXPECT_EQ(streamAll(json, indent, chunkSize), expected);
+        }
+    }
+}
+
+TEST(JsonStreamSerializer, Scalars)
+{
+    expectMatchesDump(nullptr);
+    expectMatchesDump(42);
+    expectMatchesDump(-42);
+    expectMatchesDump(4.2);
+    expectMatchesDump(true);
+    expectMatchesDump("string");
+}
+
+TEST(JsonStreamSerializer, EmptyContainers)
+{
+    expectMatchesDump(nlohmann::json::object());
+    expectMatchesDump(nlohmann::json::array());
+    expectMatchesDump(nlohmann::json::parse(R"({"a": {}, "b": [[], {}]})"));
+}
+
+TEST(JsonStreamSerializer, Nested)
+{
+    expectMatchesDump(nlohmann::json::parse(
+        R"({"@odata.id": "/redfish/v1", "Members": [{"Id": 1}, {"Id": 2,
+        "Links": {"Chassis": [{"@odata.id": "/redfish/v1/Chassis/1"}]}}],
+        "Members@odata.count": 2, "Status": {"State": "Enabled"}})"));
+}
+
+TEST(JsonStreamSerializer, Escaping)
+{
+    nlohmann::json json;
+    json["quote\"key"] = "new\nline\ttab\"quote\"";
+    json["unicode"] = "caf\xc3\xa9";
+    // Invalid utf-8 is replaced, same as dump()
+    json["invalid\xff"] = "bad\xff";
+    expectMatchesDump(json);
+}
+
+TEST(JsonStreamSerializer, ReleaseWhenSerialized)
+{
+    nlohmann::json json = {{"Name", "value"}};
+    JsonStreamSerializer serializer(nlohmann::json(json), 2);
+    serializer.fill(4096);
+    ASSERT_TRUE(serializer.isSerialized());
+    EXPECT_EQ(serializer.release(), json.dump(2));
+}
+
+TEST(JsonStreamSerializer, FillStopsEarly)
+{
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        members.emplace_back(nlohmann::json::object_t{{"Id", i}});
+    }
+    JsonStreamSerializer serializer(nlohmann::json(members), 2);
+    serializer.fill(100);
+    EXPECT_FALSE(serializer.isSerialized());
+    // Serialization stops shortly after the requested size is reached
+    EXPECT_GE(serializer.pending().size(), 100U);
+    EXPECT_LT(serializer.pending().size(), 200U);
+}
+
+// Approximates a SensorCollection with $expand, one of the larger payloads
+// bmcweb commonly returns
+nlohmann::json generateSensorCollection(size_t count)
+{
+    nlohmann::json ret;
+    ret["@odata.id"] = "/redfish/v1/Chassis/chassis/Sensors";
+    ret["@odata.type"] = "#SensorCollection.SensorCollection";
+    ret["Name"] = "Sensors";
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < count; i++)
+    {
+        std::string id = "temperature_" + std::to_string(i);
+        nlohmann::json::object_t sensor;
+        sensor["@odata.id"] = "/redfish/v1/Chassis/chassis/Sensors/" + id;
+        sensor["@odata.type"] = "#Sensor.v1_2_0.Sensor";
+        sensor["Id"] = id;
+        sensor["Name"] = id;
+        sensor["Reading"] = 40.5;
+        sensor["ReadingType"] = "Temperature";
+        sensor["ReadingUnits"] = "Cel";
+        sensor["Status"] = {{"Health", "OK"}, {"State", "Enabled"}};
+        sensor["Thresholds"] = {
+            {"UpperCaution", {{"Reading", 80.0}}},
+            {"UpperCritical", {{"Reading", 95.0}}},
+        };
+        members.emplace_back(std::move(sensor));
+    }
+    ret["Members@odata.count"] = members.size();
+    ret["Members"] = std::move(members);
+    return ret;
+}
+
+TEST(JsonStreamSerializer, CompactIsSmaller)
+{
+    nlohmann::json json = generateSensorCollection(10);
+    std::string indented = streamAll(json, 2, 4096);
+    std::string compact = streamAll(json, -1, 4096);
+
+    EXPECT_EQ(nlohmann::json::parse(compact), json);
+    // Whitespace makes up well over 20% of an indented collection
+    EXPECT_LT(compact.size() * 10, indented.size() * 8);
+}
+
+} // namespace
+} // namespace bmcweb
@@ -0,0 +1,156 @@
+#include "app.hpp"
+#include "http_request.hpp"
+#include "redfish.hpp"
+#include "routing.hpp"
+#include "verb.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+size_t allocationCount = 0;
+} // namespace
+
+// Count every allocation made by this test binary
+void* operator new(size_t size)
+{
+    allocationCount++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace crow
+{
+namespace
+{
+
+// Indexed by HttpVerb
+constexpr std::array<boost::beast::http::verb, maxVerbIndex + 1U> boostVerbs{
+    boost::beast::http::verb::delete_, boost::beast::http::verb::get,
+    boost::beast::http::verb::head,    boost::beast::http::verb::options,
+    boost::beast::http::verb::patch,   boost::beast::http::verb::post,
+    boost::beast::http::verb::put,
+};
+
+// Turns a rule into a url that it matches
+std::string fillParameters(std::string_view rule)
+{
+    std::string url;
+    while (!rule.empty())
+    {
+        if (rule.starts_with("<str>"))
+        {
+            url += "x";
+            rule.remove_prefix(5);
+        }
+        else if (rule.starts_with("<string>"))
+        {
+            url += "x";
+            rule.remove_prefix(8);
+        }
+        else if (rule.starts_with("<path>"))
+        {
+            url += "x/y";
+            rule.remove_prefix(6);
+        }
+        else
+        {
+            url += rule.front();
+            rule.remove_prefix(1);
+        }
+    }
+    return url;
+}
+
+TEST(RouterBenchmark, LookupAllRedfishRoutes)
+{
+    constexpr size_t iterations = 20;
+
+    App app;
+    redfish::RedfishService redfish(app);
+    app.validate();
+
+    std::vector<Request> requests;
+    for (const BaseRule* rule : app.getAllRules())
+    {
+        std::string url = fillParameters(rule->rule);
+        for (size_t method = 0; method <= maxVerbIndex; method++)
+        {
+            if ((rule->getMethods() & (1U << method)) == 0U)
+            {
+                continue;
+            }
+            std::error_code ec;
+            requests.emplace_back(
+                Request::Body{boostVerbs[method], url, 11}, ec);
+            ASSERT_FALSE(ec);
+        }
+    }
+    ASSERT_FALSE(requests.empty());
+
+    // Every request finds a route, and warms up anything built on first use
+    for (const Request& req : requests)
+    {
+        EXPECT_NE(app.findRoute(req).route.rule, nullptr) << req.target();
+    }
+
+    size_t found = 0;
+    size_t before = allocationCount;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (const Request& req : requests)
+        {
+            if (app.findRoute(req).route.rule != nullptr)
+            {
+                found++;
+            }
+        }
+    }
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() -
+                                       start;
+    size_t lookups = iterations * requests.size();
+    size_t allocations = allocationCount - before;
+    EXPECT_EQ(found, lookups);
+
+    RecordProperty("routes", std::to_string(app.getAllRules().size()));
+    RecordProperty("lookups", std::to_string(lookups));
+    RecordProperty("nsPerLookup",
+                   std::to_string(static_cast<size_t>(elapsed.count()) /
+                                  lookups));
+    RecordProperty("allocationsPerLookup",
+                   std::to_string(allocations / lookups));
+    // Params and the Allow header are views, so looking up never allocates
+    EXPECT_EQ(allocations, 0U);
+}
+
+} // namespace
+} // namespace crow
@@ -98,6 +98,45 @@ TEST(Router, OverlapingRoutes)
     EXPECT_TRUE(barCalled);
 }
 
+TEST(Router, VerbsMatchingDifferentRoutes)
+{
+    // Callback handler that does nothing
+    auto nullCallback = [](const Request&,
+                           const std::shared_ptr<bmcweb::AsyncResp>&,
+                           const std::string&) {};
+    auto patchCallback = [](const Request&,
+                            const std::shared_ptr<bmcweb::AsyncResp>&) {};
+
+    Router router;
+    std::error_code ec;
+
+    router.newRuleTagged<getParameterTag("/foo/<str>")>("/foo/<str>")
+        .methods(boost::beast::http::verb::get)(nullCallback);
+    router.newRuleTagged<getParameterTag("/foo/bar")>("/foo/bar")
+        .methods(boost::beast::http::verb::patch)(patchCallback);
+    router.validate();
+
+    Request req{{boost::beast::http::verb::get, "/foo/bar", 11}, ec};
+    Router::FindRouteResponse found = router.findRoute(req);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/foo/<str>");
+    ASSERT_EQ(found.route.params.size(), 1U);
+    EXPECT_EQ(found.route.params[0], "bar");
+
+    Request patchReq{{boost::beast::http::verb::patch, "/foo/bar", 11}, ec};
+    found = router.findRoute(patchReq);
+    EXPECT_EQ(found.allowHeader, "GET, PATCH");
+    ASSERT_NE(found.route.rule, nullptr);
+    EXPECT_EQ(found.route.rule->rule, "/foo/bar");
+    EXPECT_TRUE(found.route.params.empty());
+
+    Request otherReq{{boost::beast::http::verb::patch, "/foo/baz", 11}, ec};
+    found = router.findRoute(otherReq);
+    EXPECT_EQ(found.allowHeader, "GET");
+    EXPECT_EQ(found.route.rule, nullptr);
+}
+
 TEST(Router, 404)
 {
     bool notFoundCalled = false;
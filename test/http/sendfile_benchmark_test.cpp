@@ -0,0 +1,164 @@
+#include "file_test_utilities.hpp"
+#include "http/http_body.hpp"
+#include "http/sendfile.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/file_base.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+using Socket = boost::asio::local::stream_protocol::socket;
+
+// Reads everything sent to a socket until the peer closes it
+struct Receiver
+{
+    Socket& socket;
+    std::string data;
+    std::array<char, 65536> buf{};
+
+    void start()
+    {
+        socket.async_read_some(boost::asio::buffer(buf),
+                               [this](const boost::system::error_code& ec,
+                                      size_t bytesRead) {
+            data.append(buf.data(), bytesRead);
+            if (!ec)
+            {
+                start();
+            }
+        });
+    }
+};
+
+// Sends a file the way bmcweb did before sendfile, by reading it through
+// HttpBody::writer into a userspace buffer.
+struct ReadLoopSender
+{
+    Socket& socket;
+    boost::beast::http::response<HttpBody> res;
+    std::optional<HttpBody::writer> writer;
+
+    void start(const std::string& path)
+    {
+        boost::system::error_code ec;
+        res.body().open(path.c_str(), boost::beast::file_mode::read, ec);
+        ASSERT_FALSE(ec);
+        writer.emplace(res.base(), res.body());
+        sendNext();
+    }
+
+    void sendNext()
+    {
+        boost::system::error_code ec;
+        auto out = writer->get(ec);
+        ASSERT_FALSE(ec);
+        ASSERT_TRUE(out);
+        bool more = out->second;
+        boost::asio::async_write(
+            socket, out->first,
+            [this, more](const boost::system::error_code& ec2, size_t) {
+            ASSERT_FALSE(ec2);
+            if (more)
+            {
+                sendNext();
+                return;
+            }
+            socket.close();
+        });
+    }
+};
+
+std::string generateFileData()
+{
+    std::string data;
+    data.reserve(32UL * 1024UL * 1024UL);
+    while (data.size() < 32UL * 1024UL * 1024UL)
+    {
+        data += std::to_string(data.size());
+    }
+    return data;
+}
+
+double megabytesPerSecond(size_t bytes, std::chrono::steady_clock::duration d)
+{
+    double seconds = std::chrono::duration<double>(d).count();
+    return static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds;
+}
+
+// Compares sendfile throughput against the read loop HttpBody::writer uses.
+// Results are recorded as test properties, visible with --gtest_output.
+TEST(AsyncSendFileBenchmark, ThroughputComparedToReadLoop)
+{
+    std::string data = generateFileData();
+    TemporaryFileHandle file(data);
+
+    std::chrono::steady_clock::duration readLoopTime{};
+    {
+        boost::asio::io_context io;
+        Socket sender(io);
+        Socket receiverSocket(io);
+        boost::asio::local::connect_pair(sender, receiverSocket);
+        Receiver receiver{receiverSocket, {}};
+        receiver.data.reserve(data.size());
+        receiver.start();
+        ReadLoopSender readLoop{sender, {}, std::nullopt};
+        auto start = std::chrono::steady_clock::now();
+        readLoop.start(file.stringPath);
+        io.run();
+        readLoopTime = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(receiver.data.size(), data.size());
+    }
+
+    std::chrono::steady_clock::duration sendFileTime{};
+    {
+        int fd = open(file.stringPath.c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        boost::asio::io_context io;
+        Socket sender(io);
+        Socket receiverSocket(io);
+        boost::asio::local::connect_pair(sender, receiverSocket);
+        Receiver receiver{receiverSocket, {}};
+        receiver.data.reserve(data.size());
+        receiver.start();
+        auto start = std::chrono::steady_clock::now();
+        asyncSendFile(sender, fd, 0, data.size(),
+                      [&](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            sender.close();
+        });
+        io.run();
+        sendFileTime = std::chrono::steady_clock::now() - start;
+        close(fd);
+        EXPECT_EQ(receiver.data.size(), data.size());
+    }
+
+    RecordProperty("ReadLoopMBps",
+                   std::to_string(megabytesPerSecond(data.size(),
+                                                     readLoopTime)));
+    RecordProperty("SendFileMBps",
+                   std::to_string(megabytesPerSecond(data.size(),
+                                                     sendFileTime)));
+}
+
+} // namespace
+} // namespace bmcweb
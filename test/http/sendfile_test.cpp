@@ -0,0 +1,137 @@
+#include "file_test_utilities.hpp"
+#include "http/sendfile.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+using Socket = boost::asio::local::stream_protocol::socket;
+
+// Reads everything sent to a socket until the peer closes it
+struct Receiver
+{
+    Socket& socket;
+    std::string data;
+    std::array<char, 65536> buf{};
+
+    void start()
+    {
+        socket.async_read_some(boost::asio::buffer(buf),
+                               [this](const boost::system::error_code& ec,
+                                      size_t bytesRead) {
+            data.append(buf.data(), bytesRead);
+            if (!ec)
+            {
+                start();
+            }
+        });
+    }
+};
+
+// Several times what the socket buffers hold, so the file goes out over
+// many sendfile calls
+std::string generateFileData()
+{
+    std::string data;
+    while (data.size() < 1024UL * 1024UL)
+    {
+        data += std::to_string(data.size());
+    }
+    return data;
+}
+
+TEST(AsyncSendFile, SendsWholeFile)
+{
+    std::string data = generateFileData();
+    TemporaryFileHandle file(data);
+    int fd = open(file.stringPath.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    boost::asio::io_context io;
+    Socket sender(io);
+    Socket receiverSocket(io);
+    boost::asio::local::connect_pair(sender, receiverSocket);
+    Receiver receiver{receiverSocket, {}};
+    receiver.start();
+
+    bool called = false;
+    asyncSendFile(sender, fd, 0, data.size(),
+                  [&](const boost::system::error_code& ec, size_t sent) {
+        EXPECT_FALSE(ec);
+        EXPECT_EQ(sent, data.size());
+        called = true;
+        sender.close();
+    });
+    io.run();
+    close(fd);
+
+    EXPECT_TRUE(called);
+    EXPECT_EQ(receiver.data, data);
+}
+
+TEST(AsyncSendFile, Offset)
+{
+    TemporaryFileHandle file("0123456789");
+    int fd = open(file.stringPath.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    boost::asio::io_context io;
+    Socket sender(io);
+    Socket receiverSocket(io);
+    boost::asio::local::connect_pair(sender, receiverSocket);
+    Receiver receiver{receiverSocket, {}};
+    receiver.start();
+
+    asyncSendFile(sender, fd, 4, 3,
+                  [&](const boost::system::error_code& ec, size_t sent) {
+        EXPECT_FALSE(ec);
+        EXPECT_EQ(sent, 3U);
+        sender.close();
+    });
+    io.run();
+    close(fd);
+
+    EXPECT_EQ(receiver.data, "456");
+}
+
+TEST(AsyncSendFile, FileShorterThanLength)
+{
+    TemporaryFileHandle file("0123456789");
+    int fd = open(file.stringPath.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    boost::asio::io_context io;
+    Socket sender(io);
+    Socket receiverSocket(io);
+    boost::asio::local::connect_pair(sender, receiverSocket);
+    Receiver receiver{receiverSocket, {}};
+    receiver.start();
+
+    asyncSendFile(sender, fd, 0, 20,
+                  [&](const boost::system::error_code& ec, size_t sent) {
+        EXPECT_EQ(ec, boost::asio::error::eof);
+        EXPECT_EQ(sent, 10U);
+        sender.close();
+    });
+    io.run();
+    close(fd);
+}
+
+} // namespace
+} // namespace bmcweb
@@ -78,6 +78,14 @@ TEST(getPreferredContentType, PositiveTest)
     EXPECT_EQ(getPreferredContentType("*/*", cborJson), ContentType::ANY);
 }
 
+TEST(getPreferredContentType, IgnoresMediaTypeParameters)
+{
+    std::array<ContentType, 2> cborJson{ContentType::CBOR, ContentType::JSON};
+    EXPECT_EQ(getPreferredContentType("application/json;format=compact",
+                                      cborJson),
+              ContentType::JSON);
+}
+
 TEST(getPreferredContentType, NegativeTest)
 {
     std::array<ContentType, 1> contentType{ContentType::CBOR};
@@ -85,5 +93,32 @@ TEST(getPreferredContentType, NegativeTest)
         getPreferredContentType("text/html, application/json", contentType),
         ContentType::NoMatch);
 }
+
+TEST(getJsonFormat, NoParameter)
+{
+    EXPECT_EQ(getJsonFormat(""), JsonFormat::Default);
+    EXPECT_EQ(getJsonFormat("*/*"), JsonFormat::Default);
+    EXPECT_EQ(getJsonFormat("application/json"), JsonFormat::Default);
+    EXPECT_EQ(getJsonFormat("application/json;q=0.8"), JsonFormat::Default);
+}
+
+TEST(getJsonFormat, FormatParameter)
+{
+    EXPECT_EQ(getJsonFormat("application/json;format=compact"),
+              JsonFormat::Compact);
+    EXPECT_EQ(getJsonFormat("application/json; format=pretty"),
+              JsonFormat::Pretty);
+    EXPECT_EQ(getJsonFormat("text/html, application/json;q=0.9;format=compact"),
+              JsonFormat::Compact);
+}
+
+TEST(getJsonFormat, ParameterOnOtherMediaType)
+{
+    EXPECT_EQ(getJsonFormat("text/html;format=compact, application/json"),
+              JsonFormat::Default);
+    EXPECT_EQ(getJsonFormat("application/json;format=unknown"),
+              JsonFormat::Default);
+}
+
 } // namespace
 } // namespace http_helpers
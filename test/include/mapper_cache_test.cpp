@@ -0,0 +1,152 @@
+#include "mapper_cache.hpp"
+
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+using Paths = std::vector<std::string>;
+using Cache = MapperCache<Paths>;
+using Clock = Cache::Clock;
+
+TEST(MapperCache, HitAfterComplete)
+{
+    Cache cache(std::chrono::seconds(60));
+    Clock::time_point now = Clock::now();
+    EXPECT_EQ(cache.find("GetSubTreePaths /sensors", now), nullptr);
+
+    Paths result;
+    std::shared_ptr<Cache::Flight> flight = cache.join(
+        "GetSubTreePaths /sensors",
+        [&result](const boost::system::error_code& ec, const Paths& paths) {
+        EXPECT_FALSE(ec);
+        result = paths;
+    });
+    ASSERT_NE(flight, nullptr);
+    cache.complete("GetSubTreePaths /sensors", flight, {}, {"/sensors/a"},
+                   now);
+    EXPECT_EQ(result, Paths{"/sensors/a"});
+
+    std::shared_ptr<const Paths> cached =
+        cache.find("GetSubTreePaths /sensors", now);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(*cached, Paths{"/sensors/a"});
+    EXPECT_EQ(cache.find("GetSubTreePaths /inventory", now), nullptr);
+
+    EXPECT_EQ(cache.getStats().hits, 1U);
+    EXPECT_EQ(cache.getFlightStats().calls, 1U);
+}
+
+TEST(MapperCache, EntriesExpire)
+{
+    Cache cache(std::chrono::seconds(60));
+    Clock::time_point now = Clock::now();
+    std::shared_ptr<Cache::Flight> flight = cache.join(
+        "key", [](const boost::system::error_code&, const Paths&) {});
+    ASSERT_NE(flight, nullptr);
+    cache.complete("key", flight, {}, {"/a"}, now);
+
+    EXPECT_NE(cache.find("key", now + std::chrono::seconds(59)), nullptr);
+    EXPECT_EQ(cache.find("key", now + std::chrono::seconds(60)), nullptr);
+}
+
+TEST(MapperCache, IdenticalQueriesShareOneCall)
+{
+    Cache cache(std::chrono::seconds(60));
+    size_t called = 0;
+    auto callback = [&called](const boost::system::error_code&,
+                              const Paths& paths) {
+        EXPECT_EQ(paths, Paths{"/a"});
+        called++;
+    };
+    std::shared_ptr<Cache::Flight> flight = cache.join("key", callback);
+    ASSERT_NE(flight, nullptr);
+    EXPECT_EQ(cache.join("key", callback), nullptr);
+    EXPECT_EQ(cache.join("key", callback), nullptr);
+    EXPECT_EQ(called, 0U);
+
+    cache.complete("key", flight, {}, {"/a"}, Clock::now());
+    EXPECT_EQ(called, 3U);
+    EXPECT_EQ(cache.getFlightStats().calls, 1U);
+    EXPECT_EQ(cache.getFlightStats().coalesced, 2U);
+}
+
+TEST(MapperCache, ErrorsAreNotCached)
+{
+    Cache cache(std::chrono::seconds(60));
+    Clock::time_point now = Clock::now();
+    boost::system::error_code received;
+    std::shared_ptr<Cache::Flight> flight = cache.join(
+        "key", [&received](const boost::system::error_code& ec,
+                           const Paths&) { received = ec; });
+    ASSERT_NE(flight, nullptr);
+    boost::system::error_code ec =
+        boost::system::errc::make_error_code(boost::system::errc::io_error);
+    cache.complete("key", flight, ec, {}, now);
+    EXPECT_EQ(received, ec);
+    EXPECT_EQ(cache.find("key", now), nullptr);
+
+    // The next query makes a new call
+    EXPECT_NE(cache.join("key", [](const boost::system::error_code&,
+                                   const Paths&) {}),
+              nullptr);
+}
+
+TEST(MapperCache, ReplyInFlightAcrossInvalidateIsNotStored)
+{
+    Cache cache(std::chrono::seconds(60));
+    Clock::time_point now = Clock::now();
+    size_t called = 0;
+    auto callback = [&called](const boost::system::error_code&,
+                              const Paths&) { called++; };
+    std::shared_ptr<Cache::Flight> stale = cache.join("key", callback);
+    ASSERT_NE(stale, nullptr);
+
+    cache.invalidate();
+    // Queries after the invalidation don't wait for the stale reply
+    std::shared_ptr<Cache::Flight> fresh = cache.join("key", callback);
+    ASSERT_NE(fresh, nullptr);
+
+    cache.complete("key", stale, {}, {"/old"}, now);
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(cache.find("key", now), nullptr);
+
+    cache.complete("key", fresh, {}, {"/new"}, now);
+    EXPECT_EQ(called, 2U);
+    std::shared_ptr<const Paths> cached = cache.find("key", now);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(*cached, Paths{"/new"});
+    EXPECT_EQ(cache.getStats().invalidations, 1U);
+}
+
+TEST(MapperCache, EvictsOldestEntry)
+{
+    Cache cache(std::chrono::seconds(60));
+    Clock::time_point now = Clock::now();
+    for (size_t i = 0; i <= Cache::maxEntries; i++)
+    {
+        std::string key = std::to_string(i);
+        std::shared_ptr<Cache::Flight> flight = cache.join(
+            key, [](const boost::system::error_code&, const Paths&) {});
+        ASSERT_NE(flight, nullptr);
+        cache.complete(key, flight, {}, {key},
+                       now + std::chrono::milliseconds(i));
+    }
+    Clock::time_point later = now + std::chrono::seconds(1);
+    EXPECT_EQ(cache.find("0", later), nullptr);
+    EXPECT_NE(cache.find("1", later), nullptr);
+    EXPECT_NE(cache.find(std::to_string(Cache::maxEntries), later), nullptr);
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -0,0 +1,83 @@
+#include "single_flight.hpp"
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+using Objects = std::vector<std::string>;
+using Flights = SingleFlight<Objects>;
+
+TEST(SingleFlight, IdenticalCallsShareOneReply)
+{
+    Flights flights;
+    std::vector<Objects> replies;
+    auto callback = [&replies](const boost::system::error_code& ec,
+                               const Objects& objects) {
+        EXPECT_FALSE(ec);
+        replies.push_back(objects);
+    };
+
+    std::shared_ptr<Flights::Flight> sensors =
+        flights.join("GetManagedObjects sensors /", callback);
+    ASSERT_NE(sensors, nullptr);
+    std::shared_ptr<Flights::Flight> network =
+        flights.join("GetManagedObjects network /", callback);
+    ASSERT_NE(network, nullptr);
+    for (size_t i = 0; i < 9; i++)
+    {
+        EXPECT_EQ(flights.join("GetManagedObjects sensors /", callback),
+                  nullptr);
+    }
+    EXPECT_TRUE(replies.empty());
+
+    flights.complete("GetManagedObjects sensors /", sensors, {}, {"/temp"});
+    ASSERT_EQ(replies.size(), 10U);
+    for (const Objects& reply : replies)
+    {
+        EXPECT_EQ(reply, Objects{"/temp"});
+    }
+
+    // Once the reply is in, the next call is made afresh
+    std::shared_ptr<Flights::Flight> again =
+        flights.join("GetManagedObjects sensors /", callback);
+    EXPECT_NE(again, nullptr);
+
+    EXPECT_EQ(flights.getStats().calls, 3U);
+    EXPECT_EQ(flights.getStats().coalesced, 9U);
+}
+
+TEST(SingleFlight, CallsAfterClearDontJoin)
+{
+    Flights flights;
+    size_t called = 0;
+    auto callback = [&called](const boost::system::error_code&,
+                              const Objects&) { called++; };
+    std::shared_ptr<Flights::Flight> first = flights.join("key", callback);
+    ASSERT_NE(first, nullptr);
+
+    flights.clear();
+    std::shared_ptr<Flights::Flight> second = flights.join("key", callback);
+    ASSERT_NE(second, nullptr);
+    EXPECT_FALSE(flights.finish("key", first));
+
+    // The first reply mustn't end the second flight
+    Flights::deliver(first, {}, {});
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(flights.join("key", callback), nullptr);
+
+    flights.complete("key", second, {}, {});
+    EXPECT_EQ(called, 3U);
+}
+
+} // namespace
+} // namespace dbus::utility
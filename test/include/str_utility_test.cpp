@@ -74,4 +74,14 @@ TEST(AsciiIEquals, Positive)
     EXPECT_FALSE(asciiIEquals("bar", "foo"));
 }
 
+TEST(TrimSpaces, Positive)
+{
+    using bmcweb::trimSpaces;
+    EXPECT_EQ(trimSpaces(" gzip\t"), "gzip");
+    EXPECT_EQ(trimSpaces("q=0"), "q=0");
+    EXPECT_EQ(trimSpaces(" a b "), "a b");
+    EXPECT_EQ(trimSpaces(" \t "), "");
+    EXPECT_EQ(trimSpaces(""), "");
+}
+
 } // namespace
@@ -0,0 +1,109 @@
+#include "dbus_utility.hpp"
+#include "user_info_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+using Clock = UserInfoCache::Clock;
+
+dbus::utility::DBusPropertiesMap makeUserInfo(const std::string& privilege)
+{
+    return {{"UserPrivilege", privilege}, {"UserEnabled", true}};
+}
+
+TEST(UserInfoCache, HitAfterInsert)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    EXPECT_EQ(cache.lookup("root", now), nullptr);
+
+    cache.insert("root", makeUserInfo("priv-admin"), cache.generation(), now);
+    UserInfoCache::UserInfo userInfo = cache.lookup("root", now);
+    ASSERT_NE(userInfo, nullptr);
+    EXPECT_EQ(*userInfo, makeUserInfo("priv-admin"));
+    EXPECT_EQ(cache.lookup("operator", now), nullptr);
+
+    EXPECT_EQ(cache.getStats().hits, 1U);
+    EXPECT_EQ(cache.getStats().misses, 2U);
+}
+
+TEST(UserInfoCache, EntriesExpire)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    cache.insert("root", makeUserInfo("priv-admin"), cache.generation(), now);
+
+    EXPECT_NE(cache.lookup("root", now + std::chrono::seconds(29)), nullptr);
+    EXPECT_EQ(cache.lookup("root", now + std::chrono::seconds(30)), nullptr);
+}
+
+TEST(UserInfoCache, InvalidateDropsEntries)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    cache.insert("root", makeUserInfo("priv-admin"), cache.generation(), now);
+    cache.invalidate();
+    EXPECT_EQ(cache.lookup("root", now), nullptr);
+    EXPECT_EQ(cache.getStats().invalidations, 1U);
+}
+
+TEST(UserInfoCache, ResultFromBeforeInvalidateIsNotStored)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    uint64_t generation = cache.generation();
+    // The user changes while GetUserInfo is in flight
+    cache.invalidate();
+    cache.insert("root", makeUserInfo("priv-admin"), generation, now);
+    EXPECT_EQ(cache.lookup("root", now), nullptr);
+}
+
+TEST(UserInfoCache, ExpiredPasswordIsNotStored)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    dbus::utility::DBusPropertiesMap userInfo = makeUserInfo("priv-admin");
+    userInfo.emplace_back("UserPasswordExpired", true);
+    cache.insert("root", userInfo, cache.generation(), now);
+    EXPECT_EQ(cache.lookup("root", now), nullptr);
+
+    userInfo.back().second = false;
+    cache.insert("root", userInfo, cache.generation(), now);
+    EXPECT_NE(cache.lookup("root", now), nullptr);
+}
+
+TEST(UserInfoCache, ZeroTtlDisablesCache)
+{
+    UserInfoCache cache(std::chrono::seconds(0));
+    Clock::time_point now = Clock::now();
+    cache.insert("root", makeUserInfo("priv-admin"), cache.generation(), now);
+    EXPECT_EQ(cache.lookup("root", now), nullptr);
+}
+
+TEST(UserInfoCache, EvictsOldestWhenFull)
+{
+    UserInfoCache cache(std::chrono::seconds(30));
+    Clock::time_point now = Clock::now();
+    for (size_t i = 0; i < UserInfoCache::maxEntries; i++)
+    {
+        cache.insert("user" + std::to_string(i), makeUserInfo("priv-user"),
+                     cache.generation(), now + std::chrono::milliseconds(i));
+    }
+    cache.insert("newuser", makeUserInfo("priv-user"), cache.generation(),
+                 now + std::chrono::seconds(1));
+
+    EXPECT_EQ(cache.lookup("user0", now), nullptr);
+    EXPECT_NE(cache.lookup("user1", now), nullptr);
+    EXPECT_NE(cache.lookup("newuser", now), nullptr);
+}
+
+} // namespace
+} // namespace bmcweb
@@ -0,0 +1,129 @@
+#include "worker_pool.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <cstddef>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+TEST(WorkerPool, NoThreadsRunsInline)
+{
+    boost::asio::io_context io;
+    WorkerPool pool(io, 0);
+
+    std::optional<int> result;
+    EXPECT_TRUE(pool.post("Inline", []() { return 42; },
+                          [&result](int value) { result = value; }));
+    // With no workers, the completion doesn't wait for the io_context
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, 42);
+
+    auto it = pool.stats().find("Inline");
+    ASSERT_NE(it, pool.stats().end());
+    EXPECT_EQ(it->second.count, 1U);
+    EXPECT_EQ(it->second.ranInline, 1U);
+}
+
+TEST(WorkerPool, StatsAreKeptPerTask)
+{
+    boost::asio::io_context io;
+    WorkerPool pool(io, 0);
+
+    EXPECT_TRUE(pool.post("A", []() { return 1; }, [](int /*value*/) {}));
+    EXPECT_TRUE(pool.post("A", []() { return 2; }, [](int /*value*/) {}));
+    EXPECT_TRUE(pool.post("B", []() { return std::string("b"); },
+                          [](std::string&& /*value*/) {}));
+
+    EXPECT_EQ(pool.stats().size(), 2U);
+    EXPECT_EQ(pool.stats().find("A")->second.count, 2U);
+    EXPECT_EQ(pool.stats().find("B")->second.count, 1U);
+}
+
+#ifndef BOOST_ASIO_DISABLE_THREADS
+TEST(WorkerPool, CompletionRunsOnIoContext)
+{
+    boost::asio::io_context io;
+    WorkerPool pool(io, 2);
+
+    std::thread::id ioThread = std::this_thread::get_id();
+    std::thread::id workThread;
+    std::thread::id completionThread;
+    std::optional<int> result;
+    bool queued = pool.post(
+        "Threaded",
+        [&workThread]() {
+        workThread = std::this_thread::get_id();
+        return 7;
+    },
+        [&](int value) {
+        completionThread = std::this_thread::get_id();
+        result = value;
+    });
+    EXPECT_TRUE(queued);
+    EXPECT_FALSE(result);
+
+    // Joining the pool guarantees the completion has been posted
+    pool.stop();
+    io.run();
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, 7);
+    EXPECT_NE(workThread, ioThread);
+    EXPECT_EQ(completionThread, ioThread);
+
+    auto it = pool.stats().find("Threaded");
+    ASSERT_NE(it, pool.stats().end());
+    EXPECT_EQ(it->second.count, 1U);
+    EXPECT_EQ(it->second.ranInline, 0U);
+}
+
+TEST(WorkerPool, FullQueueTurnsWorkAway)
+{
+    boost::asio::io_context io;
+    WorkerPool pool(io, 1);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    size_t completed = 0;
+    for (size_t i = 0; i < WorkerPool::maxPendingPerThread; i++)
+    {
+        EXPECT_TRUE(pool.post(
+            "Blocked",
+            [released]() {
+            released.wait();
+            return 0;
+        },
+            [&completed](int /*value*/) { completed++; }));
+    }
+
+    // Nothing more is queued, and nothing runs on this thread instead
+    bool ran = false;
+    EXPECT_FALSE(pool.post("Blocked", [&ran]() {
+        ran = true;
+        return 0;
+    }, [](int /*value*/) {}));
+    EXPECT_FALSE(ran);
+
+    release.set_value();
+    pool.stop();
+    io.run();
+    EXPECT_EQ(completed, WorkerPool::maxPendingPerThread);
+
+    auto it = pool.stats().find("Blocked");
+    ASSERT_NE(it, pool.stats().end());
+    EXPECT_EQ(it->second.count, WorkerPool::maxPendingPerThread);
+    EXPECT_EQ(it->second.rejected, 1U);
+}
+#endif
+
+} // namespace
+} // namespace bmcweb
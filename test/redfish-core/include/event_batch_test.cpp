@@ -0,0 +1,86 @@
+#include "event_batch.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using Sent = std::map<std::string, std::shared_ptr<const std::string>>;
+
+Sent flush(EventBatch& batch, uint64_t& eventId, size_t& payloads)
+{
+    Sent sent;
+    payloads = batch.flush(
+        eventId, [&sent](const std::string& id,
+                         const std::shared_ptr<const std::string>& msg) {
+        EXPECT_TRUE(sent.emplace(id, msg).second);
+    });
+    return sent;
+}
+
+std::vector<std::string> messageIds(const std::string& msg)
+{
+    nlohmann::json event = nlohmann::json::parse(msg);
+    std::vector<std::string> ids;
+    size_t memberId = 0;
+    for (const nlohmann::json& record : event["Events"])
+    {
+        EXPECT_EQ(record["MemberId"], memberId++);
+        ids.emplace_back(record["MessageId"]);
+    }
+    return ids;
+}
+
+TEST(EventBatch, SharesEachDistinctEvent)
+{
+    EventBatch batch;
+    batch.add({{"MessageId", "A"}}, {"1", "2", "3"});
+    batch.add({{"MessageId", "B"}}, {"1", "2"});
+    batch.add({{"MessageId", "C"}}, {"3"});
+    // Records nobody subscribed to aren't kept
+    batch.add({{"MessageId", "D"}}, {});
+    EXPECT_EQ(batch.size(), 3U);
+
+    uint64_t eventId = 10;
+    size_t payloads = 0;
+    Sent sent = flush(batch, eventId, payloads);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(payloads, 2U);
+    EXPECT_EQ(eventId, 12U);
+    ASSERT_EQ(sent.size(), 3U);
+
+    // The same records are sent as the very same Event
+    EXPECT_EQ(sent["1"], sent["2"]);
+    EXPECT_NE(sent["1"], sent["3"]);
+    EXPECT_EQ(messageIds(*sent["1"]), (std::vector<std::string>{"A", "B"}));
+    EXPECT_EQ(messageIds(*sent["3"]), (std::vector<std::string>{"A", "C"}));
+
+    nlohmann::json event = nlohmann::json::parse(*sent["1"]);
+    EXPECT_EQ(event["@odata.type"], "#Event.v1_4_0.Event");
+    EXPECT_EQ(event["Name"], "Event Log");
+    EXPECT_NE(event["Id"], nlohmann::json::parse(*sent["3"])["Id"]);
+}
+
+TEST(EventBatch, EmptyBatchSendsNothing)
+{
+    EventBatch batch;
+    uint64_t eventId = 1;
+    size_t payloads = 0;
+    EXPECT_TRUE(flush(batch, eventId, payloads).empty());
+    EXPECT_EQ(payloads, 0U);
+    EXPECT_EQ(eventId, 1U);
+}
+
+} // namespace
+} // namespace redfish
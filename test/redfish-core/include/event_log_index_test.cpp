@@ -0,0 +1,168 @@
+#include "event_log_index.hpp"
+
+#include <stdlib.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+class EventLogIndexTest : public ::testing::Test
+{
+  protected:
+    EventLogIndexTest()
+    {
+        std::string path = (std::filesystem::temp_directory_path() /
+                            "bmcweb_event_log_index_test_XXXXXX")
+                               .string();
+        EXPECT_NE(mkdtemp(path.data()), nullptr);
+        dir = path;
+    }
+
+    EventLogIndexTest(const EventLogIndexTest&) = delete;
+    EventLogIndexTest(EventLogIndexTest&&) = delete;
+    EventLogIndexTest& operator=(const EventLogIndexTest&) = delete;
+    EventLogIndexTest& operator=(EventLogIndexTest&&) = delete;
+
+    ~EventLogIndexTest() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    void append(const std::string& name, const std::string& data)
+    {
+        std::ofstream file(dir / name, std::ios::app | std::ios::binary);
+        file << data;
+    }
+
+    static Entries read(EventLogIndex& index, size_t skip, size_t top)
+    {
+        Entries entries;
+        EXPECT_TRUE(index.readEntries(
+            skip, top, [&entries](const std::string& id,
+                                  const std::string& line) {
+            entries.emplace_back(id, line);
+            return true;
+        }));
+        return entries;
+    }
+
+    std::filesystem::path dir;
+};
+
+const std::string started =
+    "2020-01-01T00:00:00.000000+00:00 OpenBMC.0.1.ServiceStarted,a";
+const std::string startedAgain =
+    "2020-01-01T00:00:00.000000+00:00 OpenBMC.0.1.ServiceStarted,b";
+const std::string unknown =
+    "2020-01-01T00:00:01.000000+00:00 OpenBMC.0.1.NotAMessage,c";
+const std::string later =
+    "2020-01-01T00:00:02.000000+00:00 OpenBMC.0.1.ServiceStarted,d";
+
+TEST_F(EventLogIndexTest, PagesOldestFileFirst)
+{
+    append("redfish.1", started + "\n" + startedAgain + "\n");
+    append("redfish", unknown + "\n" + later + "\n");
+    append("other", later + "\n");
+    EventLogIndex index(dir, "redfish");
+
+    // The entry without a registry message isn't listed
+    EXPECT_EQ(index.size(), 3U);
+    Entries all = read(index, 0, 10);
+    ASSERT_EQ(all.size(), 3U);
+    EXPECT_EQ(all[0].second, started);
+    EXPECT_EQ(all[1].second, startedAgain);
+    EXPECT_EQ(all[1].first, all[0].first + "_1");
+    EXPECT_EQ(all[2].second, later);
+
+    Entries page = read(index, 1, 1);
+    ASSERT_EQ(page.size(), 1U);
+    EXPECT_EQ(page[0], all[1]);
+    EXPECT_TRUE(read(index, 3, 10).empty());
+
+    std::string line;
+    ASSERT_TRUE(index.readEntry(all[2].first, line));
+    EXPECT_EQ(line, later);
+    EXPECT_FALSE(index.readEntry("0", line));
+    EXPECT_EQ(index.getStats().files, 2U);
+    EXPECT_EQ(index.getStats().lines, 4U);
+}
+
+TEST_F(EventLogIndexTest, ReadsOnlyAppendedLines)
+{
+    append("redfish", started + "\n");
+    EventLogIndex index(dir, "redfish");
+    EXPECT_EQ(index.size(), 1U);
+    uint64_t bytesRead = index.getStats().bytesRead;
+    EXPECT_EQ(bytesRead, started.size() + 1);
+
+    // A line that's still being written isn't indexed yet
+    append("redfish", later);
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_EQ(index.getStats().bytesRead, bytesRead + later.size());
+
+    // Nor read again while the files stay as they are
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_EQ(index.getStats().bytesRead, bytesRead + later.size());
+
+    // Changes are found without being told of them
+    append("redfish", "\n");
+    EXPECT_EQ(index.size(), 2U);
+    Entries all = read(index, 0, 10);
+    ASSERT_EQ(all.size(), 2U);
+    EXPECT_EQ(all[1].second, later);
+}
+
+TEST_F(EventLogIndexTest, RotatedFilesKeepTheirEntries)
+{
+    append("redfish", started + "\n" + startedAgain + "\n");
+    EventLogIndex index(dir, "redfish");
+    Entries before = read(index, 0, 10);
+    uint64_t bytesRead = index.getStats().bytesRead;
+
+    std::filesystem::rename(dir / "redfish", dir / "redfish.1");
+    append("redfish", later + "\n");
+    index.changed();
+
+    Entries after = read(index, 0, 10);
+    ASSERT_EQ(after.size(), 3U);
+    EXPECT_EQ(after[0], before[0]);
+    EXPECT_EQ(after[1], before[1]);
+    EXPECT_EQ(after[2].second, later);
+    // Only the new file was read
+    EXPECT_EQ(index.getStats().bytesRead, bytesRead + later.size() + 1);
+
+    std::filesystem::remove(dir / "redfish.1");
+    index.changed();
+    Entries remaining = read(index, 0, 10);
+    ASSERT_EQ(remaining.size(), 1U);
+    EXPECT_EQ(remaining[0], after[2]);
+}
+
+TEST_F(EventLogIndexTest, TruncatedFileIsReadAgain)
+{
+    append("redfish", started + "\n" + startedAgain + "\n");
+    EventLogIndex index(dir, "redfish");
+    EXPECT_EQ(index.size(), 2U);
+
+    std::filesystem::resize_file(dir / "redfish", 0);
+    append("redfish", later + "\n");
+    index.changed();
+    Entries all = read(index, 0, 10);
+    ASSERT_EQ(all.size(), 1U);
+    EXPECT_EQ(all[0].second, later);
+    EXPECT_EQ(index.getStats().reindexed, 1U);
+}
+
+} // namespace
+} // namespace redfish
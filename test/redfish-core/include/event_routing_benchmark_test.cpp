@@ -0,0 +1,129 @@
+#include "event_routing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+constexpr size_t subscriptionCount = 500;
+constexpr size_t eventCount = 20000;
+
+struct Subscriber
+{
+    std::string id;
+    std::vector<std::string> resourceTypes;
+    std::vector<std::string> registryPrefixes;
+    std::vector<std::string> registryMsgIds;
+};
+
+long long microseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+// Finds the subscribers to an event log entry by looking at each in turn, as
+// EventServiceManager used to
+size_t scan(const std::vector<Subscriber>& subscribers,
+            const std::string& prefix, const std::string& messageKey)
+{
+    size_t matched = 0;
+    for (const Subscriber& subscriber : subscribers)
+    {
+        if (!subscriber.registryPrefixes.empty() &&
+            std::ranges::find(subscriber.registryPrefixes, prefix) ==
+                subscriber.registryPrefixes.end())
+        {
+            continue;
+        }
+        if (!subscriber.registryMsgIds.empty() &&
+            std::ranges::find(subscriber.registryMsgIds, messageKey) ==
+                subscriber.registryMsgIds.end())
+        {
+            continue;
+        }
+        matched++;
+    }
+    return matched;
+}
+
+TEST(EventRoutingBenchmark, FiveHundredSubscribers)
+{
+    const std::vector<std::string> prefixes = {"OpenBMC", "Base",
+                                               "TaskEvent", "ResourceEvent"};
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 64; i++)
+    {
+        keys.emplace_back(std::format("Message{}", i));
+    }
+
+    // Most subscribers ask for a few messages, some for whole registries,
+    // and a few for everything
+    std::vector<Subscriber> subscribers;
+    EventRouting routing;
+    for (size_t i = 0; i < subscriptionCount; i++)
+    {
+        Subscriber& subscriber = subscribers.emplace_back();
+        subscriber.id = std::to_string(1000000 + i);
+        if (i % 50 == 0)
+        {
+            // Everything
+        }
+        else if (i % 5 == 0)
+        {
+            subscriber.registryPrefixes = {prefixes[i % prefixes.size()]};
+        }
+        else
+        {
+            subscriber.registryPrefixes = {prefixes[i % prefixes.size()]};
+            for (size_t j = 0; j < 4; j++)
+            {
+                subscriber.registryMsgIds.push_back(
+                    keys[(i * 7 + j * 13) % keys.size()]);
+            }
+        }
+        routing.add(subscriber.id, true, subscriber.resourceTypes,
+                    subscriber.registryPrefixes, subscriber.registryMsgIds);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (size_t i = 0; i < eventCount; i++)
+    {
+        scanned += scan(subscribers, prefixes[i % prefixes.size()],
+                        keys[i * 31 % keys.size()]);
+    }
+    auto scanTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    size_t routed = 0;
+    for (size_t i = 0; i < eventCount; i++)
+    {
+        routed += routing
+                      .matchLogEntry(prefixes[i % prefixes.size()],
+                                     keys[i * 31 % keys.size()])
+                      .size();
+    }
+    auto routeTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(routed, scanned);
+    EXPECT_GT(routed, 0U);
+
+    RecordProperty("subscriptions", std::to_string(subscriptionCount));
+    RecordProperty("events", std::to_string(eventCount));
+    RecordProperty("deliveries", std::to_string(routed));
+    RecordProperty("scan_us", std::to_string(microseconds(scanTime)));
+    RecordProperty("routed_us", std::to_string(microseconds(routeTime)));
+}
+
+} // namespace
+} // namespace redfish
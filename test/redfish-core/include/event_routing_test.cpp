@@ -0,0 +1,68 @@
+#include "event_routing.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+std::vector<std::string> sorted(std::vector<std::string> ids)
+{
+    std::ranges::sort(ids);
+    return ids;
+}
+
+TEST(EventRouting, MatchesResourceTypes)
+{
+    EventRouting routing;
+    routing.add("1", true, {}, {}, {});
+    routing.add("2", false, {"Task", "Task"}, {}, {});
+    routing.add("3", true, {"Chassis"}, {}, {});
+    EXPECT_EQ(routing.size(), 3U);
+
+    using Ids = std::vector<std::string>;
+    EXPECT_EQ(sorted(routing.matchResourceType("Task")), (Ids{"1", "2"}));
+    EXPECT_EQ(sorted(routing.matchResourceType("Chassis")), (Ids{"1", "3"}));
+    EXPECT_EQ(routing.matchResourceType("Thermal"), Ids{"1"});
+
+    routing.remove("1");
+    routing.remove("4");
+    EXPECT_EQ(routing.matchResourceType("Task"), Ids{"2"});
+    EXPECT_TRUE(routing.matchResourceType("Thermal").empty());
+}
+
+TEST(EventRouting, MatchesLogEntries)
+{
+    EventRouting routing;
+    routing.add("any", true, {}, {}, {});
+    routing.add("prefix", true, {}, {"OpenBMC"}, {});
+    routing.add("key", true, {}, {}, {"ServiceStarted"});
+    routing.add("both", true, {}, {"OpenBMC", "Base"},
+                {"ServiceStarted", "Success"});
+    // Metric report subscriptions aren't sent log entries
+    routing.add("report", false, {}, {}, {});
+
+    using Ids = std::vector<std::string>;
+    EXPECT_EQ(sorted(routing.matchLogEntry("OpenBMC", "ServiceStarted")),
+              (Ids{"any", "both", "key", "prefix"}));
+    EXPECT_EQ(sorted(routing.matchLogEntry("OpenBMC", "Other")),
+              (Ids{"any", "prefix"}));
+    EXPECT_EQ(sorted(routing.matchLogEntry("Base", "Success")),
+              (Ids{"any", "both"}));
+    EXPECT_EQ(routing.matchLogEntry("Base", "Other"), Ids{"any"});
+
+    // Filing a subscription again replaces its filters
+    routing.add("both", true, {}, {"Base"}, {"Other"});
+    EXPECT_EQ(routing.matchLogEntry("Base", "Success"), Ids{"any"});
+    EXPECT_EQ(sorted(routing.matchLogEntry("Base", "Other")),
+              (Ids{"any", "both"}));
+    EXPECT_EQ(routing.size(), 5U);
+}
+
+} // namespace
+} // namespace redfish
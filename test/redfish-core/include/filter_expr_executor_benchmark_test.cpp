@@ -0,0 +1,118 @@
+#include "filter_expr_executor.hpp"
+#include "filter_expr_parser_ast.hpp"
+#include "filter_expr_printer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+constexpr size_t entryCount = 50000;
+
+nlohmann::json generateLogEntries()
+{
+    constexpr std::array<std::string_view, 3> severities{"OK", "Warning",
+                                                         "Critical"};
+    nlohmann::json::array_t members;
+    members.reserve(entryCount);
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        nlohmann::json::object_t entry;
+        entry["@odata.id"] = std::format(
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/{}", i);
+        entry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+        entry["Id"] = std::to_string(i);
+        entry["Name"] = "System Event Log Entry";
+        entry["EntryType"] = "Event";
+        entry["Message"] = std::format("Sensor {} reading crossed a threshold",
+                                       i % 97);
+        entry["MessageId"] = "OpenBMC.0.1.SensorThresholdWarningHighGoingHigh";
+        entry["Severity"] = severities[i % severities.size()];
+        // One entry a minute through 2023
+        entry["Created"] = std::format(
+            "2023-{:02}-{:02}T{:02}:{:02}:00+00:00", 1 + (i / 4320) % 12,
+            1 + (i / 1440) % 28, (i / 60) % 24, i % 60);
+        members.emplace_back(std::move(entry));
+    }
+    nlohmann::json body;
+    body["Members"] = std::move(members);
+    body["Members@odata.count"] = entryCount;
+    return body;
+}
+
+long long microseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+TEST(FilterBenchmark, FiftyThousandLogEntries)
+{
+    std::optional<filter_ast::LogicalAnd> ast =
+        parseFilter("(Severity eq 'Critical' or Severity eq 'Warning') and "
+                    "Created ge '2023-06-01T00:00:00+00:00' and "
+                    "MessageId ne 'OpenBMC.0.1.ResourceEvent'");
+    ASSERT_TRUE(ast);
+    const nlohmann::json body = generateLogEntries();
+    const nlohmann::json::array_t& members =
+        body["Members"].get_ref<const nlohmann::json::array_t&>();
+
+    // Compiling the filter again for each member.  This isn't the AST
+    // evaluator that CompiledFilter replaced, so the two arms only show what
+    // compiling once and evaluating by column saves.
+    auto start = std::chrono::steady_clock::now();
+    size_t perMemberMatched = 0;
+    for (const nlohmann::json& member : members)
+    {
+        FilterPropertyLookup lookup =
+            [&member](std::string_view property) -> const nlohmann::json* {
+            auto it = member.find(property);
+            if (it == member.end())
+            {
+                return nullptr;
+            }
+            return &*it;
+        };
+        if (CompiledFilter(*ast).matches(lookup))
+        {
+            perMemberMatched++;
+        }
+    }
+    auto perMemberTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    nlohmann::json filtered = body;
+    auto copyTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(applyFilter(filtered, CompiledFilter(*ast)));
+    auto compiledTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GT(perMemberMatched, 0U);
+    EXPECT_LT(perMemberMatched, entryCount);
+    EXPECT_EQ(filtered["Members"].size(), perMemberMatched);
+    EXPECT_EQ(filtered["Members@odata.count"], perMemberMatched);
+
+    RecordProperty("Members", std::to_string(entryCount));
+    RecordProperty("Matched", std::to_string(perMemberMatched));
+    RecordProperty("PerMemberMicroseconds",
+                   std::to_string(microseconds(perMemberTime)));
+    RecordProperty("CopyMicroseconds", std::to_string(microseconds(copyTime)));
+    RecordProperty("CompiledMicroseconds",
+                   std::to_string(microseconds(compiledTime)));
+}
+
+} // namespace
+} // namespace redfish
@@ -2,8 +2,11 @@
 #include "filter_expr_parser_ast.hpp"
 #include "filter_expr_printer.hpp"
 
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "gmock/gmock.h"
 
@@ -247,4 +250,69 @@ TEST(FilterParser, Dates)
     filterFalse("'2021-11-30T22:41:35.124+00:00' le Created", members);
 }
 
+TEST(FilterParser, UpdatesCount)
+{
+    nlohmann::json json =
+        R"({"Members": [{"Count": 1}, {"Count": 2}, {"Count": 3}],
+            "Members@odata.count": 3})"_json;
+    std::optional<filter_ast::LogicalAnd> ast = parseFilter("Count ge 2");
+    ASSERT_TRUE(ast);
+    EXPECT_TRUE(applyFilter(json, *ast));
+    EXPECT_EQ(json["Members"].size(), 2);
+    EXPECT_EQ(json["Members@odata.count"], 2);
+}
+
+TEST(FilterParser, MemberLookup)
+{
+    std::optional<filter_ast::LogicalAnd> ast =
+        parseFilter("Severity eq 'Critical' and Count gt 1");
+    ASSERT_TRUE(ast);
+    CompiledFilter filter(*ast);
+
+    std::vector<std::string> looked;
+    nlohmann::json::object_t properties = {{"Severity", "Critical"},
+                                           {"Count", 2}};
+    FilterPropertyLookup lookup =
+        [&](std::string_view property) -> const nlohmann::json* {
+        looked.emplace_back(property);
+        auto it = properties.find(property);
+        if (it == properties.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    };
+    EXPECT_TRUE(filter.matches(lookup));
+    EXPECT_EQ(looked, (std::vector<std::string>{"Severity", "Count"}));
+
+    properties["Severity"] = "OK";
+    EXPECT_FALSE(filter.matches(lookup));
+}
+
+TEST(FilterParser, CompiledOverMembers)
+{
+    std::optional<filter_ast::LogicalAnd> ast = parseFilter(
+        "(Severity eq 'Critical' or Severity eq 'Warning') and "
+        "Created gt '2021-11-30T22:41:35.123+00:00' and not (Count eq 1)");
+    ASSERT_TRUE(ast);
+    CompiledFilter filter(*ast);
+    EXPECT_EQ(filter.getProperties(),
+              (std::vector<std::string>{"Severity", "Created", "Count"}));
+
+    const nlohmann::json::array_t members = R"([
+        {"Severity": "Critical", "Created": "2021-12-01T00:00:00+00:00",
+         "Count": 2},
+        {"Severity": "OK", "Created": "2021-12-01T00:00:00+00:00",
+         "Count": 2},
+        {"Severity": "Warning", "Created": "2021-11-30T00:00:00+00:00",
+         "Count": 2},
+        {"Severity": "Warning", "Created": "2021-12-01T00:00:00+00:00",
+         "Count": 1},
+        {"Severity": "Warning", "Created": "2021-12-01T00:00:00+00:00",
+         "Count": 3}
+    ])"_json;
+    EXPECT_EQ(filter.matches(members),
+              (std::vector<uint8_t>{1, 0, 0, 0, 1}));
+}
+
 } // namespace redfish
@@ -0,0 +1,138 @@
+#include "gzfile.hpp"
+
+#include <stdlib.h>
+#include <zlib.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr size_t fileCount = 5;
+constexpr size_t bytesPerFile = 10UL * 1024UL * 1024UL;
+
+long long microseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+// Counts entries by inflating every file from the start a kilobyte at a
+// time, as each request used to
+size_t countFromStart(const std::vector<std::filesystem::path>& paths)
+{
+    HostLogParser parser;
+    parser.setKeepFrom(UINT64_MAX);
+    auto onEntry = [](uint64_t, std::string_view, size_t) { return true; };
+    std::array<char, 1024> buffer{};
+    for (const std::filesystem::path& path : paths)
+    {
+        gzFile file = gzopen(path.c_str(), "r");
+        EXPECT_NE(file, nullptr);
+        int bytes = 0;
+        while ((bytes = gzread(file, buffer.data(), buffer.size())) > 0)
+        {
+            parser.feed(
+                std::string_view(buffer.data(), static_cast<size_t>(bytes)),
+                onEntry);
+        }
+        gzclose(file);
+    }
+    parser.finish(onEntry);
+    return parser.getEntries();
+}
+
+TEST(GzFileBenchmark, FiftyMegabyteHostLog)
+{
+    std::string dirPath = (std::filesystem::temp_directory_path() /
+                           "bmcweb_gzfile_benchmark_XXXXXX")
+                              .string();
+    ASSERT_NE(mkdtemp(dirPath.data()), nullptr);
+    std::filesystem::path dir = dirPath;
+
+    // Oldest first, as getHostLoggerFiles() orders them
+    std::vector<std::filesystem::path> paths;
+    size_t line = 0;
+    for (size_t i = fileCount; i > 0; i--)
+    {
+        std::string data;
+        while (data.size() < bytesPerFile)
+        {
+            data += std::format(
+                "[{:>8}.{:06}] host: DIMM {} temperature {} C, fan {} rpm\r\n",
+                line / 1000, line % 1000 * 997, line % 24, 30 + line % 41,
+                4000 + line * 37 % 9000);
+            line++;
+        }
+        paths.emplace_back(dir / std::format("log.{}.gz", i));
+        gzFile file = gzopen(paths.back().c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(gzwrite(file, data.data(),
+                          static_cast<unsigned int>(data.size())),
+                  static_cast<int>(data.size()));
+        gzclose(file);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t fromStartCount = countFromStart(paths);
+    auto fromStart = std::chrono::steady_clock::now() - start;
+
+    // The first request indexes every file
+    start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<const GzFileIndex>> files;
+    for (const std::filesystem::path& path : paths)
+    {
+        auto index = std::make_shared<GzFileIndex>(path);
+        ASSERT_TRUE(index->build());
+        files.emplace_back(std::move(index));
+    }
+    std::vector<std::string> coldEntries;
+    size_t coldCount = 0;
+    ASSERT_TRUE(
+        readHostLogEntries(files, 90000, 10, coldEntries, coldCount));
+    auto cold = std::chrono::steady_clock::now() - start;
+
+    // Later requests start inflating at the access point before the page
+    start = std::chrono::steady_clock::now();
+    std::vector<std::string> warmEntries;
+    size_t warmCount = 0;
+    ASSERT_TRUE(
+        readHostLogEntries(files, 90000, 10, warmEntries, warmCount));
+    auto warm = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::string> lastEntries;
+    size_t lastCount = 0;
+    ASSERT_TRUE(readHostLogEntries(files, fromStartCount - 10, 10,
+                                   lastEntries, lastCount));
+    auto last = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(coldCount, fromStartCount);
+    EXPECT_EQ(warmCount, fromStartCount);
+    EXPECT_EQ(warmEntries, coldEntries);
+    ASSERT_EQ(warmEntries.size(), 10U);
+    EXPECT_TRUE(warmEntries[0].starts_with("[      90."));
+    EXPECT_EQ(lastEntries.size(), 10U);
+
+    RecordProperty("entries", std::to_string(fromStartCount));
+    RecordProperty("inflate_from_start_us",
+                   std::to_string(microseconds(fromStart)));
+    RecordProperty("index_and_page_us", std::to_string(microseconds(cold)));
+    RecordProperty("indexed_page_us", std::to_string(microseconds(warm)));
+    RecordProperty("indexed_last_page_us", std::to_string(microseconds(last)));
+
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace
@@ -0,0 +1,163 @@
+#include "gzfile.hpp"
+
+#include <stdlib.h>
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::vector<std::string> parseAll(const std::vector<std::string_view>& chunks)
+{
+    std::vector<std::string> entries;
+    HostLogParser parser;
+    auto onEntry = [&entries](uint64_t number, std::string_view entry,
+                              size_t) {
+        EXPECT_EQ(number, entries.size());
+        entries.emplace_back(entry);
+        return true;
+    };
+    for (std::string_view chunk : chunks)
+    {
+        parser.feed(chunk, onEntry);
+    }
+    parser.finish(onEntry);
+    return entries;
+}
+
+TEST(HostLogParser, SplitsOnDelimiters)
+{
+    std::vector<std::string> expected = {"a", "b", "\n", "c", "d"};
+    EXPECT_EQ(parseAll({"a\r\nb\n\nc\rd"}), expected);
+    // However the text is split up
+    EXPECT_EQ(parseAll({"a\r", "\nb\n", "\nc", "\r", "d"}), expected);
+    EXPECT_EQ(parseAll({"\n"}), std::vector<std::string>{"\n"});
+    EXPECT_TRUE(parseAll({""}).empty());
+}
+
+class GzFileIndexTest : public ::testing::Test
+{
+  protected:
+    GzFileIndexTest()
+    {
+        std::string path = (std::filesystem::temp_directory_path() /
+                            "bmcweb_gzfile_test_XXXXXX")
+                               .string();
+        EXPECT_NE(mkdtemp(path.data()), nullptr);
+        dir = path;
+    }
+
+    GzFileIndexTest(const GzFileIndexTest&) = delete;
+    GzFileIndexTest(GzFileIndexTest&&) = delete;
+    GzFileIndexTest& operator=(const GzFileIndexTest&) = delete;
+    GzFileIndexTest& operator=(GzFileIndexTest&&) = delete;
+
+    ~GzFileIndexTest() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::shared_ptr<const GzFileIndex> write(const std::string& name,
+                                             std::string_view data,
+                                             bool compress)
+    {
+        std::filesystem::path path = dir / name;
+        if (compress)
+        {
+            gzFile file = gzopen(path.c_str(), "w");
+            EXPECT_NE(file, nullptr);
+            EXPECT_EQ(gzwrite(file, data.data(),
+                              static_cast<unsigned int>(data.size())),
+                      static_cast<int>(data.size()));
+            gzclose(file);
+        }
+        else
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << data;
+        }
+        auto index = std::make_shared<GzFileIndex>(path);
+        EXPECT_TRUE(index->build());
+        contents += data;
+        return index;
+    }
+
+    std::filesystem::path dir;
+    // Everything written, one file after another
+    std::string contents;
+};
+
+std::string generateLog(size_t lines, size_t first)
+{
+    std::string log;
+    for (size_t i = first; i < first + lines; i++)
+    {
+        log += std::format("[{:>8}.{:03}] host: console line {}", i / 1000,
+                           i % 1000, i * 7919 % 100003);
+        log += i % 5 == 0 ? "\r\n" : "\n";
+        if (i % 97 == 0)
+        {
+            log += "\n";
+        }
+    }
+    return log;
+}
+
+TEST_F(GzFileIndexTest, PagesMatchReadingFromTheStart)
+{
+    std::vector<std::shared_ptr<const GzFileIndex>> files;
+    // Large enough for several access points in each file, with entries
+    // that carry on from one file into the next
+    files.push_back(write("log.2.gz", generateLog(60000, 0) + "split ",
+                          true));
+    files.push_back(write("log.1.gz", "entry\r" + generateLog(60000, 60000),
+                          true));
+    files.push_back(write("log", "\n" + generateLog(1000, 120000) + "end",
+                          false));
+    EXPECT_GT(files[0]->getPoints().size(), 1U);
+    EXPECT_GT(files[1]->getPoints().size(), 1U);
+
+    std::vector<std::string> expected = parseAll({contents});
+    for (uint64_t skip : {0UL, 1UL, 59999UL, 60060UL, 61234UL, 121100UL,
+                          expected.size() - 3})
+    {
+        std::vector<std::string> entries;
+        size_t logCount = 0;
+        ASSERT_TRUE(readHostLogEntries(files, skip, 10, entries, logCount));
+        EXPECT_EQ(logCount, expected.size());
+        ASSERT_EQ(entries.size(),
+                  std::min<size_t>(10, expected.size() - skip));
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            EXPECT_EQ(entries[i], expected[skip + i]) << skip + i;
+        }
+    }
+
+    std::vector<std::string> entries;
+    size_t logCount = 0;
+    ASSERT_TRUE(readHostLogEntries(files, expected.size(), 10, entries,
+                                   logCount));
+    EXPECT_TRUE(entries.empty());
+    EXPECT_EQ(expected.back(), "end");
+}
+
+TEST_F(GzFileIndexTest, ChangedFileIsNotCurrent)
+{
+    std::shared_ptr<const GzFileIndex> index = write("log", "a\nb\n", false);
+    EXPECT_TRUE(index->isCurrent());
+    std::ofstream(dir / "log", std::ios::app) << "c\n";
+    EXPECT_FALSE(index->isCurrent());
+}
+
+} // namespace
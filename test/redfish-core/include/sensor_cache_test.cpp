@@ -0,0 +1,102 @@
+#include "dbus_utility.hpp"
+#include "sensor_cache.hpp"
+
+#include <sdbusplus/message/native_types.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using dbus::utility::DBusInterfacesMap;
+using dbus::utility::ManagedObjectType;
+
+const std::string valueInterface = "xyz.openbmc_project.Sensor.Value";
+
+ManagedObjectType makeSensors()
+{
+    ManagedObjectType objects;
+    objects.emplace_back(
+        sdbusplus::message::object_path(
+            "/xyz/openbmc_project/sensors/temperature/inlet"),
+        DBusInterfacesMap{{valueInterface, {{"Value", 25.0}}}});
+    objects.emplace_back(
+        sdbusplus::message::object_path(
+            "/xyz/openbmc_project/sensors/fan_tach/fan0"),
+        DBusInterfacesMap{{valueInterface, {{"Value", 3000.0}}}});
+    return objects;
+}
+
+TEST(SensorTable, SortsObjectsByPath)
+{
+    SensorTable table(makeSensors());
+    const ManagedObjectType& objects = table.getObjects();
+    ASSERT_EQ(objects.size(), 2U);
+    EXPECT_EQ(objects[0].first.str,
+              "/xyz/openbmc_project/sensors/fan_tach/fan0");
+    EXPECT_EQ(objects[1].first.str,
+              "/xyz/openbmc_project/sensors/temperature/inlet");
+    EXPECT_GT(table.memoryUsage(), 0U);
+}
+
+TEST(SensorTable, PropertiesChangedUpdatesValue)
+{
+    SensorTable table(makeSensors());
+    table.propertiesChanged("/xyz/openbmc_project/sensors/temperature/inlet",
+                            valueInterface, {{"Value", 27.5}}, {});
+    // Unknown objects and interfaces are ignored
+    table.propertiesChanged("/xyz/openbmc_project/sensors/temperature/cpu",
+                            valueInterface, {{"Value", 60.0}}, {});
+    table.propertiesChanged("/xyz/openbmc_project/sensors/fan_tach/fan0",
+                            "xyz.openbmc_project.Sensor.Threshold.Critical",
+                            {{"CriticalHigh", 9000.0}}, {});
+
+    const ManagedObjectType& objects = table.getObjects();
+    ASSERT_EQ(objects.size(), 2U);
+    EXPECT_EQ(objects[0].second.size(), 1U);
+    const auto& inlet = objects[1].second[0].second;
+    ASSERT_EQ(inlet.size(), 1U);
+    EXPECT_EQ(inlet[0].second, dbus::utility::DbusVariantType(27.5));
+
+    table.propertiesChanged("/xyz/openbmc_project/sensors/temperature/inlet",
+                            valueInterface, {{"MaxValue", 127.0}}, {"Value"});
+    ASSERT_EQ(inlet.size(), 1U);
+    EXPECT_EQ(inlet[0].first, "MaxValue");
+}
+
+TEST(SensorTable, InterfacesAddedAndRemoved)
+{
+    SensorTable table(makeSensors());
+    table.interfacesAdded(
+        "/xyz/openbmc_project/sensors/power/psu0",
+        DBusInterfacesMap{{valueInterface, {{"Value", 250.0}}}});
+    table.interfacesAdded(
+        "/xyz/openbmc_project/sensors/fan_tach/fan0",
+        DBusInterfacesMap{
+            {"xyz.openbmc_project.State.Decorator.OperationalStatus",
+             {{"Functional", true}}}});
+
+    const ManagedObjectType& objects = table.getObjects();
+    ASSERT_EQ(objects.size(), 3U);
+    EXPECT_EQ(objects[1].first.str, "/xyz/openbmc_project/sensors/power/psu0");
+    EXPECT_EQ(objects[0].second.size(), 2U);
+
+    table.interfacesRemoved("/xyz/openbmc_project/sensors/fan_tach/fan0",
+                            {valueInterface});
+    ASSERT_EQ(objects.size(), 3U);
+    EXPECT_EQ(objects[0].second.size(), 1U);
+
+    table.interfacesRemoved("/xyz/openbmc_project/sensors/power/psu0",
+                            {valueInterface});
+    ASSERT_EQ(objects.size(), 2U);
+    EXPECT_EQ(objects[1].first.str,
+              "/xyz/openbmc_project/sensors/temperature/inlet");
+}
+
+} // namespace
+} // namespace redfish
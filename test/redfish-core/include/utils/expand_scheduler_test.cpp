@@ -0,0 +1,83 @@
+#include "utils/expand_scheduler.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace redfish::query_param
+{
+namespace
+{
+
+TEST(ExpandScheduler, RunsAtMostWidthAtOnce)
+{
+    ExpandScheduler scheduler(2);
+    std::vector<size_t> started;
+    for (size_t i = 0; i < 5; i++)
+    {
+        scheduler.schedule(1, [&started, i]() { started.push_back(i); });
+    }
+    EXPECT_EQ(started, (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(scheduler.getStats().running, 2U);
+    EXPECT_EQ(scheduler.getStats().queued, 3U);
+
+    scheduler.done();
+    EXPECT_EQ(started, (std::vector<size_t>{0, 1, 2}));
+    scheduler.done();
+    scheduler.done();
+    scheduler.done();
+    EXPECT_EQ(started, (std::vector<size_t>{0, 1, 2, 3, 4}));
+    scheduler.done();
+    EXPECT_EQ(scheduler.getStats().running, 0U);
+    EXPECT_EQ(scheduler.getStats().maxQueued, 3U);
+}
+
+TEST(ExpandScheduler, ShallowerLevelsFirst)
+{
+    ExpandScheduler scheduler(1);
+    std::vector<size_t> started;
+    // Holds the only slot
+    scheduler.schedule(1, []() {});
+    scheduler.schedule(3, [&started]() { started.push_back(3); });
+    scheduler.schedule(2, [&started]() { started.push_back(2); });
+    scheduler.schedule(1, [&started]() { started.push_back(1); });
+
+    scheduler.done();
+    scheduler.done();
+    scheduler.done();
+    EXPECT_EQ(started, (std::vector<size_t>{1, 2, 3}));
+}
+
+TEST(ExpandScheduler, FinishingStraightAwayHandsOnSlot)
+{
+    ExpandScheduler scheduler(1);
+    size_t started = 0;
+    std::function<void()> start = [&scheduler, &started]() {
+        started++;
+        scheduler.done();
+    };
+    for (size_t i = 0; i < 100; i++)
+    {
+        scheduler.schedule(1, std::function<void()>(start));
+    }
+    EXPECT_EQ(started, 100U);
+    EXPECT_EQ(scheduler.getStats().running, 0U);
+    EXPECT_EQ(scheduler.getStats().maxQueued, 1U);
+}
+
+TEST(ExpandScheduler, ZeroWidthIsUnbounded)
+{
+    ExpandScheduler scheduler(0);
+    size_t started = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        scheduler.schedule(1, [&started]() { started++; });
+    }
+    EXPECT_EQ(started, 100U);
+    EXPECT_EQ(scheduler.getStats().running, 100U);
+}
+
+} // namespace
+} // namespace redfish::query_param
@@ -133,6 +133,60 @@ TEST(Delegate, SkipPositive)
     EXPECT_EQ(query.skip, 0);
 }
 
+TEST(Delegate, FilterNegativeKeepsPaging)
+{
+    Query query{
+        .skip = 10,
+        .top = 5,
+        .filter = parseFilter("Severity eq 'Critical'"),
+    };
+    QueryCapabilities capabilities{
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    // Paging has to wait until the members have been filtered
+    EXPECT_FALSE(delegated.filter);
+    EXPECT_EQ(delegated.top, std::nullopt);
+    EXPECT_EQ(delegated.skip, std::nullopt);
+    EXPECT_TRUE(query.filter);
+    EXPECT_EQ(query.top, 5);
+    EXPECT_EQ(query.skip, 10);
+}
+
+TEST(Delegate, FilterPositive)
+{
+    Query query{
+        .skip = 10,
+        .top = 5,
+        .filter = parseFilter("Severity eq 'Critical'"),
+    };
+    QueryCapabilities capabilities{
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+        .canDelegateFilter = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    EXPECT_TRUE(delegated.filter);
+    EXPECT_EQ(delegated.top, 5);
+    EXPECT_EQ(delegated.skip, 10);
+    EXPECT_FALSE(query.filter);
+}
+
+TEST(Delegate, SkipUnselectedKeepsSelect)
+{
+    Query query;
+    ASSERT_TRUE(query.selectTrie.insertNode("PowerState"));
+    QueryCapabilities capabilities{
+        .canSkipUnselected = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    // The handler sees what's selected, and the rest is still removed after
+    EXPECT_TRUE(delegated.selectTrie.isSelected("PowerState"));
+    EXPECT_FALSE(delegated.selectTrie.isSelected("UUID"));
+    EXPECT_FALSE(query.selectTrie.root.empty());
+}
+
 TEST(FormatQueryForExpand, NoSubQueryWhenQueryIsEmpty)
 {
     EXPECT_EQ(formatQueryForExpand(Query{}), "");
@@ -237,6 +291,27 @@ TEST(GetSelectParam, TrieNodesRespectAllProperties)
     EXPECT_TRUE(query.selectTrie.root.find("bar")->isSelected());
 }
 
+TEST(SelectTrie, IsSelected)
+{
+    SelectTrie trie;
+    // Everything is selected without $select
+    EXPECT_TRUE(trie.isSelected("Boot"));
+
+    ASSERT_TRUE(trie.insertNode("PowerState"));
+    ASSERT_TRUE(trie.insertNode("Boot/TrustedModuleRequiredToBoot"));
+    ASSERT_TRUE(trie.insertNode("Links"));
+    EXPECT_TRUE(trie.isSelected("PowerState"));
+    EXPECT_FALSE(trie.isSelected("UUID"));
+    // Part of Boot is selected
+    EXPECT_TRUE(trie.isSelected("Boot"));
+    EXPECT_TRUE(trie.isSelected("Boot/TrustedModuleRequiredToBoot"));
+    EXPECT_FALSE(trie.isSelected("Boot/StopBootOnFault"));
+    // All of Links is selected
+    EXPECT_TRUE(trie.isSelected("Links/Chassis"));
+    EXPECT_TRUE(trie.isSelected({"UUID", "PowerState"}));
+    EXPECT_FALSE(trie.isSelected({"UUID", "Boot/StopBootOnFault"}));
+}
+
 SelectTrie getTrie(std::span<std::string_view> properties)
 {
     SelectTrie trie;
@@ -827,6 +902,35 @@ TEST(QueryParams, PreviouslyExpanded)
                                "/redfish/v1/Chassis/5B247A_Sat2/Sensors"}));
 }
 
+TEST(QueryParams, CountExpandedAbove)
+{
+    using nlohmann::json;
+
+    json expNode = R"(
+{
+  "@odata.id": "/redfish/v1/Chassis",
+  "Links": {"Sessions": {"@odata.id": "/foobar"}},
+  "Members": [
+    {
+      "@odata.id": "/redfish/v1/Chassis/Sat1",
+      "Sensors": {"@odata.id": "/redfish/v1/Chassis/Sat1/Sensors"}
+    },
+    {"@odata.id": "/redfish/v1/Chassis/Sat2"}
+  ]
+}
+)"_json;
+
+    // The response itself isn't counted, nor is the link
+    EXPECT_EQ(countExpandedAbove(expNode, json::json_pointer("/Members/1")),
+              0);
+    EXPECT_EQ(countExpandedAbove(expNode,
+                                 json::json_pointer("/Links/Sessions")),
+              0);
+    EXPECT_EQ(countExpandedAbove(expNode,
+                                 json::json_pointer("/Members/0/Sensors")),
+              1);
+}
+
 TEST(QueryParams, DelegatedSkipExpanded)
 {
     using nlohmann::json;
@@ -3,6 +3,8 @@
 
 #include <systemd/sd-id128.h>
 
+#include <boost/url/url.hpp>
+
 #include <cstdint>
 #include <format>
 #include <memory>
@@ -63,6 +65,28 @@ TEST(LogServicesBMCJouralTest, LogServicesBMCJouralGetReturnsError)
     EXPECT_EQ(indexOut, indexIn);
 }
 
+TEST(LogServicesBMCJournalPage, ReadsOrderAndCursor)
+{
+    crow::Response res;
+    BMCJournalPage page;
+    boost::urls::url url("/Entries?order=newest&cursor=s%3Dabc%3Bi%3D1f");
+    ASSERT_TRUE(getBMCJournalPage(url.params(), page, res));
+    EXPECT_TRUE(page.newestFirst);
+    EXPECT_EQ(page.cursor, "s=abc;i=1f");
+
+    boost::urls::url oldestUrl("/Entries?order=oldest");
+    BMCJournalPage oldest;
+    ASSERT_TRUE(getBMCJournalPage(oldestUrl.params(), oldest, res));
+    EXPECT_FALSE(oldest.newestFirst);
+    EXPECT_TRUE(oldest.cursor.empty());
+
+    boost::urls::url badOrder("/Entries?order=sideways");
+    boost::urls::url emptyCursor("/Entries?cursor=");
+    BMCJournalPage bad;
+    EXPECT_FALSE(getBMCJournalPage(badOrder.params(), bad, res));
+    EXPECT_FALSE(getBMCJournalPage(emptyCursor.params(), bad, res));
+}
+
 TEST(LogServicesPostCodeParse, PostCodeParse)
 {
     uint64_t currentValue = 0;